@@ -0,0 +1,289 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <JApp/Log.h>
+#include <JApp/Logger.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+using namespace JApp;
+
+// Every allocation of the process is counted, including the logger's own threads until shutdown() has drained them.
+namespace {
+std::atomic<quint64> g_allocations { 0 };
+}
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Scenario {
+    QString target;
+    QString variant;
+    Logger::LogConfig config;
+    bool deferred = false; // LOG_INFO_F() instead of LOG_INFO()
+};
+
+struct Result {
+    double seconds = 0;           // Until shutdown() returned, every record written
+    double loggingSeconds = 0;    // Until the logging threads returned, queued records may be pending
+    quint64 records = 0;
+    quint64 allocations = 0;
+    quint64 loggingAllocations = 0;
+    std::vector<qint64> latencies; // Nanoseconds per LOG_INFO() statement
+};
+
+QList<Scenario> createScenarios(const QString& logDirectory, bool asynchronous)
+{
+    const QList<QPair<QString, Logger::OutputTarget>> targets = {
+        { "Console",    Logger::OutputTarget::Console },
+        { "File",       Logger::OutputTarget::File },
+        { "BinaryFile", Logger::OutputTarget::BinaryFile },
+        { "MappedFile", Logger::OutputTarget::MappedFile }
+    };
+
+    QList<Scenario> scenarios;
+    for (const auto& target : targets) {
+        Logger::LogConfig config;
+        config.target = target.second;
+        config.logDirectory = logDirectory;
+        config.logFilePrefix = "bench";
+        config.maxFileSize = 64 * 1024 * 1024;
+        config.maxFileCount = 2;
+        config.asynchronous = asynchronous;
+
+        scenarios.append({ target.first, "default", config });
+
+        Scenario noTimestamp { target.first, "noTimestamp", config };
+        noTimestamp.config.enableTimestamp = false;
+        scenarios.append(noTimestamp);
+
+        Scenario noFunction { target.first, "noFunction", config };
+        noFunction.config.enableFunction = false;
+        scenarios.append(noFunction);
+
+        Scenario noThreadId { target.first, "noThreadId", config };
+        noThreadId.config.enableThreadId = false;
+        scenarios.append(noThreadId);
+
+        Scenario deferred { target.first, "deferred", config };
+        deferred.deferred = true;
+        scenarios.append(deferred);
+    }
+    return scenarios;
+}
+
+void logRecords(int count, qint64* latencies, bool deferred)
+{
+    for (int i = 0; i < count; ++i) {
+        const Clock::time_point start = Clock::now();
+        if (deferred) {
+            LOG_INFO_F("benchmark record {} value {}", i, 3.14);
+        } else {
+            LOG_INFO() << "benchmark record" << i << "value" << 3.14;
+        }
+        latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    }
+}
+
+Result run(const Scenario& scenario, int threadCount, int recordsPerThread)
+{
+    Result result;
+    result.records = static_cast<quint64>(threadCount) * recordsPerThread;
+    result.latencies.resize(result.records);
+
+    Logger::instance().initialize(scenario.config);
+
+    // Warm up call sites, categories and per-thread state outside of the measurement
+    LOG_INFO() << "benchmark warm-up";
+
+    std::atomic<int> ready { 0 };
+    std::atomic<bool> go { false };
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (int t = 0; t < threadCount; ++t) {
+        qint64* latencies = result.latencies.data() + static_cast<size_t>(t) * recordsPerThread;
+        threads.emplace_back([&, latencies]() {
+            ready.fetch_add(1);
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            logRecords(recordsPerThread, latencies, scenario.deferred);
+        });
+    }
+
+    while (ready.load() < threadCount) {
+        std::this_thread::yield();
+    }
+
+    const quint64 allocationsBefore = g_allocations.load();
+    const Clock::time_point start = Clock::now();
+    go.store(true);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    result.loggingSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.loggingAllocations = g_allocations.load() - allocationsBefore;
+
+    // Drains the queue in asynchronous mode and flushes every output
+    Logger::instance().shutdown();
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.allocations = g_allocations.load() - allocationsBefore;
+
+    std::sort(result.latencies.begin(), result.latencies.end());
+    return result;
+}
+
+qint64 percentile(const std::vector<qint64>& sorted, double p)
+{
+    if (sorted.empty()) return 0;
+    const size_t index = std::min(sorted.size() - 1, static_cast<size_t>(sorted.size() * p));
+    return sorted[index];
+}
+
+QJsonObject toJson(const Scenario& scenario, int threadCount, const Result& result)
+{
+    QJsonObject config;
+    config["asynchronous"] = scenario.config.asynchronous;
+    config["enableTimestamp"] = scenario.config.enableTimestamp;
+    config["enableFunction"] = scenario.config.enableFunction;
+    config["enableThreadId"] = scenario.config.enableThreadId;
+
+    QJsonObject latency;
+    latency["p50"] = percentile(result.latencies, 0.50);
+    latency["p99"] = percentile(result.latencies, 0.99);
+    latency["p999"] = percentile(result.latencies, 0.999);
+    latency["max"] = result.latencies.empty() ? 0 : result.latencies.back();
+
+    QJsonObject json;
+    json["target"] = scenario.target;
+    json["variant"] = scenario.variant;
+    json["config"] = config;
+    json["threads"] = threadCount;
+    json["records"] = static_cast<qint64>(result.records);
+    json["seconds"] = result.seconds;
+    json["recordsPerSecond"] = result.seconds > 0 ? result.records / result.seconds : 0.0;
+    json["latencyNs"] = latency;
+    json["allocationsPerRecord"] = result.records ? double(result.allocations) / result.records : 0.0;
+
+    // What the logging threads saw, the same as above but for the shutdown in synchronous mode
+    QJsonObject logging;
+    logging["seconds"] = result.loggingSeconds;
+    logging["recordsPerSecond"] = result.loggingSeconds > 0 ? result.records / result.loggingSeconds : 0.0;
+    logging["allocationsPerRecord"] = result.records ? double(result.loggingAllocations) / result.records : 0.0;
+    json["loggingThreads"] = logging;
+    return json;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("japp-logbench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measures LOG_INFO() throughput, latency and allocations for each output target.\n"
+                                     "Console scenarios write to stdout, so redirect it when recording results.");
+    parser.addHelpOption();
+
+    QCommandLineOption recordsOption({ "n", "records" }, "Records logged per thread (default 100000).", "count", "100000");
+    QCommandLineOption threadsOption({ "t", "threads" }, "Threads of the multi-threaded runs (default: all cores).", "count");
+    QCommandLineOption asyncOption({ "a", "async" }, "Use the asynchronous logging mode.");
+    QCommandLineOption outputOption({ "o", "output" }, "JSON results file (default japp-logbench.json).", "file", "japp-logbench.json");
+    QCommandLineOption labelOption({ "l", "label" }, "Free text stored with the results, e.g. a commit hash.", "label");
+    parser.addOptions({ recordsOption, threadsOption, asyncOption, outputOption, labelOption });
+    parser.process(app);
+
+    QTextStream err(stderr);
+
+    bool ok = false;
+    const int recordsPerThread = parser.value(recordsOption).toInt(&ok);
+    if (!ok || recordsPerThread <= 0) {
+        err << "Invalid record count: " << parser.value(recordsOption) << Qt::endl;
+        return 1;
+    }
+
+    int threadCount = qMax(2, static_cast<int>(std::thread::hardware_concurrency()));
+    if (parser.isSet(threadsOption)) {
+        threadCount = parser.value(threadsOption).toInt(&ok);
+        if (!ok || threadCount <= 0) {
+            err << "Invalid thread count: " << parser.value(threadsOption) << Qt::endl;
+            return 1;
+        }
+    }
+
+    QTemporaryDir logDirectory;
+    if (!logDirectory.isValid()) {
+        err << "Failed to create a temporary log directory" << Qt::endl;
+        return 1;
+    }
+
+    QJsonArray results;
+    const QList<Scenario> scenarios = createScenarios(logDirectory.path(), parser.isSet(asyncOption));
+    for (const Scenario& scenario : scenarios) {
+        for (int threads : { 1, threadCount }) {
+            err << scenario.target << '/' << scenario.variant << ", " << threads << " thread(s)" << Qt::endl;
+            results.append(toJson(scenario, threads, run(scenario, threads, recordsPerThread)));
+        }
+    }
+
+    QJsonObject report;
+    report["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    report["label"] = parser.value(labelOption);
+    report["recordsPerThread"] = recordsPerThread;
+    report["results"] = results;
+
+    QFile output(parser.value(outputOption));
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        err << "Failed to open " << output.fileName() << Qt::endl;
+        return 1;
+    }
+    output.write(QJsonDocument(report).toJson());
+    return 0;
+}
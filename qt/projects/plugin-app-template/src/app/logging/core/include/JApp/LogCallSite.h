@@ -0,0 +1,23 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace JApp {
+
+// Static description of a LOG_*() statement. One instance lives in each call site
+// and gets a registry id at first use, so log records only carry that id.
+struct LogCallSite {
+    const char* category;
+    const char* file;
+    const char* function;
+    int line;
+    std::atomic<std::uint32_t> id { 0 };
+
+    // Rate limiting state, see Internal::LogRateLimiter
+    std::atomic<std::int64_t> rateDeadline { 0 };
+    std::atomic<std::uint32_t> suppressed { 0 };
+    std::atomic<std::int32_t> suppressedLevel { 0 };
+};
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace JApp {
+
+// Runtime level of one log category. Shared by every LOG_*() statement of that category
+// and updated by the category rules, so checking it costs a single relaxed load.
+struct LogCategory {
+    // Above every LogLevel: the category is silenced.
+    static constexpr int Off = 5;
+
+    const char* name;
+    std::atomic<int> level;       // Lowest level worth building a message for
+    std::atomic<int> outputLevel; // Lowest level written to the outputs, from the rules
+    std::atomic<int> rateLimit;   // Records per second and call site, 0 for no limit
+    std::atomic<int> rateBurst;   // Records a call site may log back to back
+    mutable std::atomic<std::uint64_t> records; // Written records, see Logger::stats()
+
+    bool isEnabled(int messageLevel) const {
+        return messageLevel >= level.load(std::memory_order_relaxed);
+    }
+
+    // False for messages only kept by the crash log.
+    bool isOutputEnabled(int messageLevel) const {
+        return messageLevel >= outputLevel.load(std::memory_order_relaxed);
+    }
+};
+
+}
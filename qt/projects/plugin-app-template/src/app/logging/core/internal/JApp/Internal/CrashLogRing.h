@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace JApp {
+    namespace Internal {
+        // Fixed-size, lock-free ring of the most recent records, kept whatever the output levels.
+        // It is dumped as text when the process crashes: dump() only uses async-signal-safe calls,
+        // so it can run from the SIGSEGV/SIGABRT handlers installed by installSignalHandlers().
+        class CrashLogRing {
+        public:
+            static constexpr std::size_t Capacity = 1024;
+            static constexpr std::size_t MessageSize = 224; // UTF-8 bytes, longer messages are cut
+
+            static CrashLogRing& instance();
+
+            // Records below this level are ignored; LogCategory::Off disables the ring.
+            void setLevel(int level) {
+                m_level.store(level, std::memory_order_relaxed);
+            }
+
+            bool accepts(int level) const {
+                return level >= m_level.load(std::memory_order_relaxed);
+            }
+
+            void record(int level, std::int64_t timestamp, std::uint32_t callSite, std::uint64_t threadId,
+                        const char16_t* message, std::size_t size);
+
+            // Where dump() writes. Not async-signal-safe, call it before a crash can happen.
+            void setDumpPath(const char* path);
+
+            // Writes the ring once per process, later calls return false.
+            bool dump();
+
+            void installSignalHandlers();
+            void restoreSignalHandlers();
+
+        private:
+            struct Slot {
+                std::atomic<std::uint64_t> sequence; // 2 * position + 1 while written, + 2 once complete
+                std::int64_t timestamp;
+                std::uint64_t threadId;
+                std::uint32_t callSite;
+                std::int32_t level;
+                std::uint32_t size;
+                char message[MessageSize];
+            };
+
+            CrashLogRing();
+
+            static void signalHandler(int signal);
+
+            Slot m_slots[Capacity];
+            std::atomic<std::uint64_t> m_next;
+            std::atomic<int> m_level;
+            std::atomic<bool> m_dumped;
+            std::atomic<bool> m_handlersInstalled;
+            char m_dumpPath[4096];
+        };
+    }
+}
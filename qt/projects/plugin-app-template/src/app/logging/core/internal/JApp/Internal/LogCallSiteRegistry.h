@@ -0,0 +1,67 @@
+#pragma once
+
+#include "JApp/LogCallSite.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace JApp {
+    namespace Internal {
+        // Maps call site ids to their static description. Ids start at 1, 0 means unknown.
+        // Lookups are lock-free; registration takes a mutex but happens once per call site.
+        class LogCallSiteRegistry {
+        public:
+            static LogCallSiteRegistry& instance();
+
+            std::uint32_t id(LogCallSite& site) {
+                const std::uint32_t id = site.id.load(std::memory_order_acquire);
+                return id ? id : registerSite(site);
+            }
+
+            // Registers a call site without static storage (e.g. messages from Qt itself).
+            // Strings are copied once and the same id is returned for identical locations.
+            std::uint32_t intern(const char* category, const char* file, const char* function, int line);
+
+            // One past the highest id handed out so far.
+            std::uint32_t endId() const {
+                return m_nextId.load(std::memory_order_acquire);
+            }
+
+            const LogCallSite* site(std::uint32_t id) const {
+                if (id == 0 || id >= MaxCallSites) return nullptr;
+                const Slot* chunk = m_chunks[id / ChunkSize].load(std::memory_order_acquire);
+                return chunk ? chunk[id % ChunkSize].load(std::memory_order_acquire) : nullptr;
+            }
+
+        private:
+            using Slot = std::atomic<const LogCallSite*>;
+
+            struct OwnedCallSite {
+                OwnedCallSite(std::string category, std::string file, std::string function, int line);
+
+                const std::string category;
+                const std::string file;
+                const std::string function;
+                LogCallSite site;
+            };
+
+            static constexpr std::uint32_t ChunkSize = 1024;
+            static constexpr std::uint32_t ChunkCount = 1024;
+            static constexpr std::uint32_t MaxCallSites = ChunkSize * ChunkCount;
+
+            LogCallSiteRegistry();
+
+            std::uint32_t registerSite(LogCallSite& site);
+            std::uint32_t store(LogCallSite& site);
+
+            std::mutex m_mutex;
+            std::atomic<std::uint32_t> m_nextId { 1 };
+            std::atomic<Slot*> m_chunks[ChunkCount];
+            std::deque<OwnedCallSite> m_ownedSites;
+            std::unordered_map<std::string, std::uint32_t> m_internedIds;
+        };
+    }
+}
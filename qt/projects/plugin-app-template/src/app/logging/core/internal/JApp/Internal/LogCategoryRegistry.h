@@ -0,0 +1,67 @@
+#pragma once
+
+#include "JApp/LogCategory.h"
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace JApp {
+    namespace Internal {
+        // Owns one LogCategory per category name and keeps their levels in sync with the rules.
+        // A rule pattern is a category name, "prefix.*" (the prefix and its subcategories),
+        // "prefix*" or "*". Later rules take precedence; unmatched categories use the default level.
+        // The capture level lets lower messages through to the crash log without writing them.
+        // The output floor is the lowest level any output accepts, so that statements every
+        // output would drop are skipped before their message is built.
+        class LogCategoryRegistry {
+        public:
+            struct Rule {
+                std::string pattern;
+                int level;
+            };
+
+            struct RateRule {
+                std::string pattern;
+                int perSecond; // 0 for no limit
+                int burst;     // 0 for one second worth of records
+            };
+
+            static LogCategoryRegistry& instance();
+
+            // Returns the category for this name, created on first use. The reference stays valid forever.
+            LogCategory& category(const char* name);
+
+            void setDefaultLevel(int level);
+            void setCaptureLevel(int level);
+            void setOutputFloor(int level);
+            void setRules(std::vector<Rule> rules);
+            void addRule(Rule rule); // Replaces the rule with the same pattern
+            void setRateRules(std::vector<RateRule> rules);
+            void addRateRule(RateRule rule); // Replaces the rule with the same pattern
+
+            // Written records per category name.
+            std::vector<std::pair<std::string, std::uint64_t>> recordCounts();
+
+        private:
+            LogCategoryRegistry() = default;
+
+            static bool matches(const std::string& pattern, const char* name);
+            int levelFor(const char* name) const;
+            void apply(LogCategory& category) const;
+            void applyRules();
+
+            std::mutex m_mutex;
+            int m_defaultLevel = 0;
+            int m_captureLevel = LogCategory::Off;
+            int m_outputFloor = 0;
+            std::vector<Rule> m_rules;
+            std::vector<RateRule> m_rateRules;
+            std::deque<std::string> m_names;
+            std::deque<LogCategory> m_categories;
+            std::unordered_map<std::string, LogCategory*> m_categoriesByName;
+        };
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace JApp {
+    namespace Internal {
+        // Records are stamped with the monotonic clock, which is cheap to read at the call site,
+        // and turned into wall time only when they are written.
+        class LogClock {
+        public:
+            // Nanoseconds on the monotonic clock.
+            static std::int64_t now() {
+                return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count();
+            }
+
+            // Nanoseconds since the Unix epoch for a value returned by now().
+            static std::int64_t toEpochNanoseconds(std::int64_t ticks) {
+                return ticks + offset().load(std::memory_order_relaxed);
+            }
+
+            // Re-reads the wall clock, so that converted times follow system clock adjustments.
+            static void synchronize() {
+                offset().store(measureOffset(), std::memory_order_relaxed);
+            }
+
+        private:
+            static std::atomic<std::int64_t>& offset() {
+                static std::atomic<std::int64_t> value { measureOffset() };
+                return value;
+            }
+
+            static std::int64_t measureOffset() {
+                const std::int64_t wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+                return wall - now();
+            }
+        };
+    }
+}
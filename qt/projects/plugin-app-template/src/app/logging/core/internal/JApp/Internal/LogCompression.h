@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+namespace JApp {
+    namespace Internal {
+        namespace LogCompression {
+            // Whether the library was built with the matching compression backend.
+            bool isGzipAvailable();
+            bool isZstdAvailable();
+
+            // Streams source into destination. On failure destination is removed
+            // and source is left untouched; the caller removes source on success.
+            bool gzipFile(const std::string& source, const std::string& destination);
+            bool zstdFile(const std::string& source, const std::string& destination);
+        }
+    }
+}
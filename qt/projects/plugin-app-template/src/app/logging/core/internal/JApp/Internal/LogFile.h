@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace JApp {
+    namespace Internal {
+        // Append-only text log file. On POSIX systems appends go straight to the file descriptor,
+        // several chunks in one writev() call, without any user-space buffer. Elsewhere they go
+        // through std::FILE and are flushed after each append. Not thread-safe: the caller locks.
+        class LogFile {
+        public:
+            struct Chunk {
+                const char* data;
+                std::size_t size;
+            };
+
+            LogFile() = default;
+            ~LogFile();
+
+            LogFile(const LogFile&) = delete;
+            LogFile& operator=(const LogFile&) = delete;
+
+            // Appends to an existing file, size() then starts at its current size.
+            bool open(const std::string& path);
+            void close();
+
+            bool isOpen() const;
+            const std::string& path() const;
+            std::int64_t size() const;
+
+            // Writes all chunks in order, resuming after partial writes.
+            bool append(const Chunk* chunks, std::size_t count);
+
+        private:
+            std::string m_path;
+            std::int64_t m_size = 0;
+#if defined(__unix__) || defined(__APPLE__)
+            int m_fd = -1;
+#else
+            std::FILE* m_file = nullptr;
+#endif
+        };
+    }
+}
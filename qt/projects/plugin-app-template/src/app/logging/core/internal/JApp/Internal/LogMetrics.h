@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace JApp {
+    namespace Internal {
+        // Latency histogram with power-of-two buckets from 1 µs to ~1 s, updated with relaxed atomics.
+        class LogHistogram {
+        public:
+            static constexpr std::size_t BucketCount = 21; // Plus one for everything above
+
+            static constexpr std::int64_t bucketBound(std::size_t bucket) {
+                return std::int64_t(1000) << bucket; // Nanoseconds
+            }
+
+            LogHistogram() {
+                for (auto& bucket : m_buckets) {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+            }
+
+            void record(std::int64_t nanoseconds) {
+                std::size_t bucket = 0;
+                while (bucket < BucketCount && nanoseconds > bucketBound(bucket)) {
+                    ++bucket;
+                }
+                m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+                m_sum.fetch_add(static_cast<std::uint64_t>(nanoseconds > 0 ? nanoseconds : 0), std::memory_order_relaxed);
+            }
+
+            // Non-cumulative count of bucket, BucketCount being the overflow bucket.
+            std::uint64_t bucketCount(std::size_t bucket) const {
+                return m_buckets[bucket].load(std::memory_order_relaxed);
+            }
+
+            std::uint64_t sum() const {
+                return m_sum.load(std::memory_order_relaxed);
+            }
+
+        private:
+            std::atomic<std::uint64_t> m_buckets[BucketCount + 1];
+            std::atomic<std::uint64_t> m_sum { 0 };
+        };
+
+        // Output written by one of the logger's built-in outputs or sinks.
+        struct LogOutputCounters {
+            std::atomic<std::uint64_t> records { 0 };
+            std::atomic<std::uint64_t> bytes { 0 };
+
+            void add(std::uint64_t size) {
+                records.fetch_add(1, std::memory_order_relaxed);
+                bytes.fetch_add(size, std::memory_order_relaxed);
+            }
+        };
+
+        // Counters the logger keeps about itself, see Logger::stats().
+        struct LogMetrics {
+            std::atomic<std::uint64_t> recordsPerLevel[5] = {};
+            std::atomic<std::uint64_t> suppressed { 0 };
+            std::atomic<std::uint64_t> rotations { 0 };
+            LogOutputCounters file;
+            LogOutputCounters mappedFile;
+            LogOutputCounters binaryFile;
+            LogHistogram mutexHold;
+            LogHistogram flushLatency;
+        };
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace JApp {
+    namespace Internal {
+        // Bounded lock-free queue (Vyukov). Safe for many producers and many consumers,
+        // which lets producers evict the oldest entry themselves when the queue is full.
+        template <typename T>
+        class LogQueue {
+        public:
+            explicit LogQueue(size_t capacity)
+                : m_capacity(roundUpToPowerOfTwo(capacity))
+                , m_mask(m_capacity - 1)
+                , m_cells(new Cell[m_capacity])
+            {
+                for (size_t i = 0; i < m_capacity; ++i) {
+                    m_cells[i].sequence.store(i, std::memory_order_relaxed);
+                }
+                m_enqueuePos.store(0, std::memory_order_relaxed);
+                m_dequeuePos.store(0, std::memory_order_relaxed);
+            }
+
+            LogQueue(const LogQueue&) = delete;
+            LogQueue& operator=(const LogQueue&) = delete;
+
+            size_t capacity() const {
+                return m_capacity;
+            }
+
+            bool tryPush(T&& value) {
+                Cell* cell = nullptr;
+                size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+                for (;;) {
+                    cell = &m_cells[pos & m_mask];
+                    const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                    const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+                    if (diff == 0) {
+                        if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            break;
+                        }
+                    } else if (diff < 0) {
+                        return false; // Full
+                    } else {
+                        pos = m_enqueuePos.load(std::memory_order_relaxed);
+                    }
+                }
+
+                cell->data = std::move(value);
+                cell->sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            bool tryPop(T& value) {
+                Cell* cell = nullptr;
+                size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+                for (;;) {
+                    cell = &m_cells[pos & m_mask];
+                    const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                    const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+
+                    if (diff == 0) {
+                        if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            break;
+                        }
+                    } else if (diff < 0) {
+                        return false; // Empty
+                    } else {
+                        pos = m_dequeuePos.load(std::memory_order_relaxed);
+                    }
+                }
+
+                value = std::move(cell->data);
+                cell->data = T();
+                cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+                return true;
+            }
+
+            // Approximate: a slot may be reserved but not yet published.
+            bool isEmpty() const {
+                return m_enqueuePos.load(std::memory_order_acquire) == m_dequeuePos.load(std::memory_order_acquire);
+            }
+
+        private:
+            struct Cell {
+                std::atomic<size_t> sequence;
+                T data;
+            };
+
+            static size_t roundUpToPowerOfTwo(size_t value) {
+                size_t result = 2;
+                while (result < value) {
+                    result <<= 1;
+                }
+                return result;
+            }
+
+            const size_t m_capacity;
+            const size_t m_mask;
+            std::unique_ptr<Cell[]> m_cells;
+            alignas(64) std::atomic<size_t> m_enqueuePos;
+            alignas(64) std::atomic<size_t> m_dequeuePos;
+        };
+    }
+}
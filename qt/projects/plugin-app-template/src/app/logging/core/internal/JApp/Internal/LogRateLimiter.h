@@ -0,0 +1,42 @@
+#pragma once
+
+#include "JApp/Internal/LogClock.h"
+#include "JApp/LogCallSite.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace JApp {
+    namespace Internal {
+        // Token bucket per call site, kept as a single deadline (GCRA): a record is admitted
+        // when the call site is less than `burst` intervals ahead of the clock. Rejected records
+        // are only counted; the logger reports the count with the next admitted record.
+        namespace LogRateLimiter {
+            inline bool acquire(LogCallSite& site, int level, int perSecond, int burst) {
+                const std::int64_t interval = 1000000000 / perSecond;
+                const std::int64_t tolerance = interval * (std::max(burst, 1) - 1);
+                const std::int64_t now = LogClock::now();
+
+                std::int64_t deadline = site.rateDeadline.load(std::memory_order_relaxed);
+                for (;;) {
+                    const std::int64_t start = std::max(deadline, now);
+                    if (start - now > tolerance) {
+                        site.suppressed.fetch_add(1, std::memory_order_relaxed);
+                        if (level > site.suppressedLevel.load(std::memory_order_relaxed)) {
+                            site.suppressedLevel.store(level, std::memory_order_relaxed);
+                        }
+                        return false;
+                    }
+                    if (site.rateDeadline.compare_exchange_weak(deadline, start + interval, std::memory_order_relaxed)) {
+                        return true;
+                    }
+                }
+            }
+
+            // True once the call site could log again, i.e. its suppressed streak is over.
+            inline bool isIdle(const LogCallSite& site) {
+                return site.rateDeadline.load(std::memory_order_relaxed) <= LogClock::now();
+            }
+        }
+    }
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace JApp {
     namespace Internal {
 		namespace LogUtils {
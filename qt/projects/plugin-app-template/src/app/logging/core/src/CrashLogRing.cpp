@@ -0,0 +1,270 @@
+#include "JApp/Internal/CrashLogRing.h"
+#include "JApp/Internal/LogCallSiteRegistry.h"
+#include "JApp/Internal/LogClock.h"
+#include "JApp/LogCategory.h"
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JAPP_CRASH_LOG_POSIX
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace JApp;
+using namespace JApp::Internal;
+
+namespace {
+
+// Encodes UTF-16 to UTF-8, stopping before a code point that doesn't fit.
+std::uint32_t encodeUtf8(const char16_t* text, std::size_t size, char* out, std::size_t capacity)
+{
+    std::size_t length = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+        char32_t codePoint = text[i];
+        if (codePoint >= 0xD800 && codePoint < 0xDC00 && i + 1 < size && text[i + 1] >= 0xDC00 && text[i + 1] < 0xE000) {
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (text[++i] - 0xDC00);
+        } else if (codePoint >= 0xD800 && codePoint < 0xE000) {
+            codePoint = 0xFFFD;
+        }
+
+        const std::size_t bytes = codePoint < 0x80 ? 1 : codePoint < 0x800 ? 2 : codePoint < 0x10000 ? 3 : 4;
+        if (length + bytes > capacity) break;
+
+        switch (bytes) {
+            case 1:
+                out[length++] = static_cast<char>(codePoint);
+                break;
+            case 2:
+                out[length++] = static_cast<char>(0xC0 | (codePoint >> 6));
+                out[length++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                break;
+            case 3:
+                out[length++] = static_cast<char>(0xE0 | (codePoint >> 12));
+                out[length++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                out[length++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                break;
+            default:
+                out[length++] = static_cast<char>(0xF0 | (codePoint >> 18));
+                out[length++] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                out[length++] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                out[length++] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+    return static_cast<std::uint32_t>(length);
+}
+
+#ifdef JAPP_CRASH_LOG_POSIX
+// Line assembly for dump(): no allocation, no locale, no stdio.
+class SignalSafeWriter {
+public:
+    explicit SignalSafeWriter(int fd) : m_fd(fd), m_size(0) {}
+    ~SignalSafeWriter() { flush(); }
+
+    void append(const char* data, std::size_t size) {
+        while (size > 0) {
+            if (m_size == sizeof(m_buffer)) flush();
+            const std::size_t chunk = size < sizeof(m_buffer) - m_size ? size : sizeof(m_buffer) - m_size;
+            std::memcpy(m_buffer + m_size, data, chunk);
+            m_size += chunk;
+            data += chunk;
+            size -= chunk;
+        }
+    }
+
+    void append(const char* text) {
+        append(text, std::strlen(text));
+    }
+
+    void appendNumber(std::int64_t value) {
+        char digits[21];
+        int pos = sizeof(digits);
+        std::uint64_t magnitude = value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+        do {
+            digits[--pos] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude);
+        if (value < 0) digits[--pos] = '-';
+        append(digits + pos, sizeof(digits) - pos);
+    }
+
+    void appendHex(std::uint64_t value) {
+        static constexpr char Hex[] = "0123456789abcdef";
+        char digits[16];
+        int pos = sizeof(digits);
+        do {
+            digits[--pos] = Hex[value & 0xF];
+            value >>= 4;
+        } while (value);
+        append(digits + pos, sizeof(digits) - pos);
+    }
+
+    void flush() {
+        const char* data = m_buffer;
+        while (m_size > 0) {
+            const ssize_t written = ::write(m_fd, data, m_size);
+            if (written <= 0) break;
+            data += written;
+            m_size -= static_cast<std::size_t>(written);
+        }
+        m_size = 0;
+    }
+
+private:
+    int m_fd;
+    std::size_t m_size;
+    char m_buffer[1024];
+};
+
+struct sigaction g_previousActions[NSIG];
+constexpr int CrashSignals[] = { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL };
+#endif
+
+}
+
+CrashLogRing::CrashLogRing()
+    : m_next(0)
+    , m_level(LogCategory::Off)
+    , m_dumped(false)
+    , m_handlersInstalled(false)
+{
+    for (Slot& slot : m_slots) {
+        slot.sequence.store(0, std::memory_order_relaxed);
+    }
+    m_dumpPath[0] = '\0';
+}
+
+CrashLogRing& CrashLogRing::instance()
+{
+    // Leaked on purpose: the ring must outlive everything that can crash
+    static CrashLogRing* ring = new CrashLogRing();
+    return *ring;
+}
+
+void CrashLogRing::record(int level, std::int64_t timestamp, std::uint32_t callSite, std::uint64_t threadId,
+                          const char16_t* message, std::size_t size)
+{
+    const std::uint64_t position = m_next.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = m_slots[position % Capacity];
+
+    // Seqlock: readers discard slots that are being written or got overwritten meanwhile
+    slot.sequence.store(2 * position + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timestamp = timestamp;
+    slot.threadId = threadId;
+    slot.callSite = callSite;
+    slot.level = level;
+    slot.size = encodeUtf8(message, size, slot.message, MessageSize);
+    slot.sequence.store(2 * position + 2, std::memory_order_release);
+}
+
+void CrashLogRing::setDumpPath(const char* path)
+{
+    std::strncpy(m_dumpPath, path ? path : "", sizeof(m_dumpPath) - 1);
+    m_dumpPath[sizeof(m_dumpPath) - 1] = '\0';
+}
+
+bool CrashLogRing::dump()
+{
+#ifdef JAPP_CRASH_LOG_POSIX
+    if (m_dumpPath[0] == '\0' || m_dumped.exchange(true)) return false;
+
+    const int fd = ::open(m_dumpPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+
+    static constexpr const char* Levels[] = { "DEBUG", "INFO ", "WARN ", "ERROR", "FATAL" };
+
+    {
+        SignalSafeWriter writer(fd);
+        writer.append("# Last log records before the crash: epoch ns | level | category | function:line | message | thread\n");
+
+        const std::uint64_t end = m_next.load(std::memory_order_acquire);
+        const std::uint64_t begin = end > Capacity ? end - Capacity : 0;
+        for (std::uint64_t position = begin; position < end; ++position) {
+            const Slot& slot = m_slots[position % Capacity];
+            const std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != 2 * position + 2) continue;
+
+            const std::int64_t timestamp = slot.timestamp;
+            const std::uint64_t threadId = slot.threadId;
+            const std::uint32_t callSite = slot.callSite;
+            const std::int32_t level = slot.level;
+            char message[MessageSize];
+            const std::uint32_t size = slot.size < MessageSize ? slot.size : MessageSize;
+            std::memcpy(message, slot.message, size);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+
+            // Registry lookups are lock-free and call sites are never freed
+            const LogCallSite* site = LogCallSiteRegistry::instance().site(callSite);
+
+            writer.appendNumber(LogClock::toEpochNanoseconds(timestamp));
+            writer.append(" | ");
+            writer.append(level >= 0 && level <= 4 ? Levels[level] : "?    ");
+            writer.append(" | ");
+            writer.append(site ? site->category : "?");
+            writer.append(" | ");
+            writer.append(site ? site->function : "?");
+            writer.append(":");
+            writer.appendNumber(site ? site->line : 0);
+            writer.append(" | ");
+            writer.append(message, size);
+            writer.append(" | ");
+            writer.appendHex(threadId);
+            writer.append("\n");
+        }
+    }
+
+    ::close(fd);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CrashLogRing::installSignalHandlers()
+{
+#ifdef JAPP_CRASH_LOG_POSIX
+    if (m_handlersInstalled.exchange(true)) return;
+
+    // Lets the handler run after a stack overflow on the installing thread
+    static char alternateStack[64 * 1024];
+    stack_t stack {};
+    stack.ss_sp = alternateStack;
+    stack.ss_size = sizeof(alternateStack);
+    ::sigaltstack(&stack, nullptr);
+
+    struct sigaction action {};
+    action.sa_handler = &CrashLogRing::signalHandler;
+    action.sa_flags = SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    for (int signal : CrashSignals) {
+        ::sigaction(signal, &action, &g_previousActions[signal]);
+    }
+#endif
+}
+
+void CrashLogRing::restoreSignalHandlers()
+{
+#ifdef JAPP_CRASH_LOG_POSIX
+    if (!m_handlersInstalled.exchange(false)) return;
+
+    for (int signal : CrashSignals) {
+        ::sigaction(signal, &g_previousActions[signal], nullptr);
+    }
+#endif
+}
+
+void CrashLogRing::signalHandler(int signal)
+{
+#ifdef JAPP_CRASH_LOG_POSIX
+    instance().dump();
+
+    // Hand the signal to whoever handled it before (by default: terminate and dump core)
+    ::sigaction(signal, &g_previousActions[signal], nullptr);
+    ::raise(signal);
+#else
+    (void)signal;
+#endif
+}
@@ -0,0 +1,80 @@
+#include "JApp/Internal/LogCallSiteRegistry.h"
+
+using namespace JApp;
+using namespace JApp::Internal;
+
+LogCallSiteRegistry::OwnedCallSite::OwnedCallSite(std::string category, std::string file, std::string function, int line)
+    : category(std::move(category))
+    , file(std::move(file))
+    , function(std::move(function))
+    , site { this->category.c_str(), this->file.c_str(), this->function.c_str(), line }
+{
+}
+
+LogCallSiteRegistry::LogCallSiteRegistry()
+{
+    for (auto& chunk : m_chunks) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+LogCallSiteRegistry& LogCallSiteRegistry::instance()
+{
+    // Leaked on purpose: records may still be written during static destruction
+    static LogCallSiteRegistry* registry = new LogCallSiteRegistry();
+    return *registry;
+}
+
+std::uint32_t LogCallSiteRegistry::intern(const char* category, const char* file, const char* function, int line)
+{
+    std::string key;
+    key.append(category ? category : "?").push_back('\0');
+    key.append(file ? file : "?").push_back('\0');
+    key.append(function ? function : "?").push_back('\0');
+    key.append(std::to_string(line));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_internedIds.find(key);
+    if (it != m_internedIds.end()) {
+        return it->second;
+    }
+
+    OwnedCallSite& owned = m_ownedSites.emplace_back(category ? category : "?",
+                                                      file ? file : "?",
+                                                      function ? function : "?",
+                                                      line);
+    const std::uint32_t id = store(owned.site);
+    m_internedIds.emplace(std::move(key), id);
+    return id;
+}
+
+std::uint32_t LogCallSiteRegistry::registerSite(LogCallSite& site)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Another thread may have registered it while we waited
+    const std::uint32_t id = site.id.load(std::memory_order_relaxed);
+    if (id) return id;
+
+    return store(site);
+}
+
+std::uint32_t LogCallSiteRegistry::store(LogCallSite& site)
+{
+    if (m_nextId >= MaxCallSites) return 0;
+
+    const std::uint32_t id = m_nextId++;
+    Slot* chunk = m_chunks[id / ChunkSize].load(std::memory_order_relaxed);
+    if (!chunk) {
+        chunk = new Slot[ChunkSize];
+        for (std::uint32_t i = 0; i < ChunkSize; ++i) {
+            chunk[i].store(nullptr, std::memory_order_relaxed);
+        }
+        m_chunks[id / ChunkSize].store(chunk, std::memory_order_release);
+    }
+
+    chunk[id % ChunkSize].store(&site, std::memory_order_release);
+    site.id.store(id, std::memory_order_release);
+    return id;
+}
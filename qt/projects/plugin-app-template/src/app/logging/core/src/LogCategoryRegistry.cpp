@@ -0,0 +1,161 @@
+#include "JApp/Internal/LogCategoryRegistry.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace JApp;
+using namespace JApp::Internal;
+
+LogCategoryRegistry& LogCategoryRegistry::instance()
+{
+    // Leaked on purpose: categories are referenced from function-local statics
+    static LogCategoryRegistry* registry = new LogCategoryRegistry();
+    return *registry;
+}
+
+LogCategory& LogCategoryRegistry::category(const char* name)
+{
+    const std::string key = name ? name : "default";
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_categoriesByName.find(key);
+    if (it != m_categoriesByName.end()) {
+        return *it->second;
+    }
+
+    const std::string& ownedName = m_names.emplace_back(key);
+    LogCategory& category = m_categories.emplace_back();
+    category.name = ownedName.c_str();
+    category.records.store(0, std::memory_order_relaxed);
+    apply(category);
+    m_categoriesByName.emplace(key, &category);
+    return category;
+}
+
+void LogCategoryRegistry::setDefaultLevel(int level)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_defaultLevel = level;
+    applyRules();
+}
+
+void LogCategoryRegistry::setCaptureLevel(int level)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_captureLevel = level;
+    applyRules();
+}
+
+void LogCategoryRegistry::setOutputFloor(int level)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_outputFloor == level) return;
+    m_outputFloor = level;
+    applyRules();
+}
+
+void LogCategoryRegistry::setRules(std::vector<Rule> rules)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_rules = std::move(rules);
+    applyRules();
+}
+
+void LogCategoryRegistry::addRule(Rule rule)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Moved last, so it still wins over the rules added in between
+    m_rules.erase(std::remove_if(m_rules.begin(), m_rules.end(), [&](const Rule& existing) {
+        return existing.pattern == rule.pattern;
+    }), m_rules.end());
+    m_rules.push_back(std::move(rule));
+    applyRules();
+}
+
+void LogCategoryRegistry::setRateRules(std::vector<RateRule> rules)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_rateRules = std::move(rules);
+    applyRules();
+}
+
+void LogCategoryRegistry::addRateRule(RateRule rule)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_rateRules.erase(std::remove_if(m_rateRules.begin(), m_rateRules.end(), [&](const RateRule& existing) {
+        return existing.pattern == rule.pattern;
+    }), m_rateRules.end());
+    m_rateRules.push_back(std::move(rule));
+    applyRules();
+}
+
+std::vector<std::pair<std::string, std::uint64_t>> LogCategoryRegistry::recordCounts()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<std::pair<std::string, std::uint64_t>> counts;
+    counts.reserve(m_categories.size());
+    for (const LogCategory& category : m_categories) {
+        counts.emplace_back(category.name, category.records.load(std::memory_order_relaxed));
+    }
+    return counts;
+}
+
+bool LogCategoryRegistry::matches(const std::string& pattern, const char* name)
+{
+    if (pattern == "*") return true;
+
+    const size_t nameLength = std::strlen(name);
+
+    // "models.*" covers "models" itself as well as "models.filters"
+    if (pattern.size() >= 2 && pattern.compare(pattern.size() - 2, 2, ".*") == 0) {
+        const size_t prefixLength = pattern.size() - 2;
+        if (nameLength == prefixLength && pattern.compare(0, prefixLength, name) == 0) return true;
+    }
+
+    if (!pattern.empty() && pattern.back() == '*') {
+        const size_t prefixLength = pattern.size() - 1;
+        return nameLength >= prefixLength && pattern.compare(0, prefixLength, name, prefixLength) == 0;
+    }
+
+    return pattern == name;
+}
+
+int LogCategoryRegistry::levelFor(const char* name) const
+{
+    // Requires m_mutex
+    for (auto it = m_rules.rbegin(); it != m_rules.rend(); ++it) {
+        if (matches(it->pattern, name)) {
+            return it->level;
+        }
+    }
+    return m_defaultLevel;
+}
+
+void LogCategoryRegistry::apply(LogCategory& category) const
+{
+    // Requires m_mutex
+    const int outputLevel = std::max(levelFor(category.name), m_outputFloor);
+    category.outputLevel.store(outputLevel, std::memory_order_relaxed);
+    category.level.store(std::min(outputLevel, m_captureLevel), std::memory_order_relaxed);
+
+    int perSecond = 0;
+    int burst = 0;
+    for (auto it = m_rateRules.rbegin(); it != m_rateRules.rend(); ++it) {
+        if (matches(it->pattern, category.name)) {
+            perSecond = std::max(it->perSecond, 0);
+            burst = it->burst > 0 ? it->burst : perSecond;
+            break;
+        }
+    }
+    category.rateBurst.store(burst, std::memory_order_relaxed);
+    category.rateLimit.store(perSecond, std::memory_order_relaxed);
+}
+
+void LogCategoryRegistry::applyRules()
+{
+    // Requires m_mutex
+    for (LogCategory& category : m_categories) {
+        apply(category);
+    }
+}
@@ -0,0 +1,120 @@
+#include "JApp/Internal/LogCompression.h"
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#ifdef JAPP_LOG_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef JAPP_LOG_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+
+constexpr size_t ChunkSize = 64 * 1024;
+
+struct FileCloser {
+    void operator()(std::FILE* file) const {
+        if (file) std::fclose(file);
+    }
+};
+
+using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+}
+
+namespace JApp {
+    namespace Internal {
+        namespace LogCompression {
+            bool isGzipAvailable() {
+#ifdef JAPP_LOG_HAS_ZLIB
+                return true;
+#else
+                return false;
+#endif
+            }
+
+            bool isZstdAvailable() {
+#ifdef JAPP_LOG_HAS_ZSTD
+                return true;
+#else
+                return false;
+#endif
+            }
+
+            bool gzipFile(const std::string& source, const std::string& destination) {
+#ifdef JAPP_LOG_HAS_ZLIB
+                FilePtr in(std::fopen(source.c_str(), "rb"));
+                if (!in) return false;
+
+                gzFile out = gzopen(destination.c_str(), "wb6");
+                if (!out) return false;
+
+                std::vector<char> buffer(ChunkSize);
+                bool ok = true;
+                size_t read = 0;
+                while (ok && (read = std::fread(buffer.data(), 1, buffer.size(), in.get())) > 0) {
+                    ok = gzwrite(out, buffer.data(), static_cast<unsigned>(read)) == static_cast<int>(read);
+                }
+                ok = ok && !std::ferror(in.get());
+                ok = gzclose(out) == Z_OK && ok;
+
+                if (!ok) std::remove(destination.c_str());
+                return ok;
+#else
+                (void)source;
+                (void)destination;
+                return false;
+#endif
+            }
+
+            bool zstdFile(const std::string& source, const std::string& destination) {
+#ifdef JAPP_LOG_HAS_ZSTD
+                FilePtr in(std::fopen(source.c_str(), "rb"));
+                if (!in) return false;
+                FilePtr out(std::fopen(destination.c_str(), "wb"));
+                if (!out) return false;
+
+                std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> context(ZSTD_createCCtx(), &ZSTD_freeCCtx);
+                if (!context) return false;
+                ZSTD_CCtx_setParameter(context.get(), ZSTD_c_compressionLevel, 3);
+
+                std::vector<char> inBuffer(ZSTD_CStreamInSize());
+                std::vector<char> outBuffer(ZSTD_CStreamOutSize());
+                bool ok = true;
+
+                for (;;) {
+                    const size_t read = std::fread(inBuffer.data(), 1, inBuffer.size(), in.get());
+                    if (std::ferror(in.get())) {
+                        ok = false;
+                        break;
+                    }
+                    const bool lastChunk = read < inBuffer.size();
+                    const ZSTD_EndDirective mode = lastChunk ? ZSTD_e_end : ZSTD_e_continue;
+
+                    ZSTD_inBuffer input { inBuffer.data(), read, 0 };
+                    bool finished = false;
+                    while (ok && !finished) {
+                        ZSTD_outBuffer output { outBuffer.data(), outBuffer.size(), 0 };
+                        const size_t remaining = ZSTD_compressStream2(context.get(), &output, &input, mode);
+                        ok = !ZSTD_isError(remaining)
+                             && std::fwrite(outBuffer.data(), 1, output.pos, out.get()) == output.pos;
+                        finished = lastChunk ? remaining == 0 : input.pos == input.size;
+                    }
+                    if (!ok || lastChunk) break;
+                }
+
+                ok = std::fclose(out.release()) == 0 && ok;
+                if (!ok) std::remove(destination.c_str());
+                return ok;
+#else
+                (void)source;
+                (void)destination;
+                return false;
+#endif
+            }
+        }
+    }
+}
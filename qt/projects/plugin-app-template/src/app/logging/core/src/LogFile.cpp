@@ -0,0 +1,135 @@
+#include "JApp/Internal/LogFile.h"
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define JAPP_LOG_FILE_POSIX
+#include <cerrno>
+#include <climits>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+using namespace JApp::Internal;
+
+LogFile::~LogFile()
+{
+    close();
+}
+
+const std::string& LogFile::path() const
+{
+    return m_path;
+}
+
+std::int64_t LogFile::size() const
+{
+    return m_size;
+}
+
+#ifdef JAPP_LOG_FILE_POSIX
+
+bool LogFile::open(const std::string& path)
+{
+    close();
+    m_path = path;
+    m_fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (m_fd < 0) return false;
+
+    struct stat status;
+    m_size = ::fstat(m_fd, &status) == 0 ? static_cast<std::int64_t>(status.st_size) : 0;
+    return true;
+}
+
+void LogFile::close()
+{
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool LogFile::isOpen() const
+{
+    return m_fd >= 0;
+}
+
+bool LogFile::append(const Chunk* chunks, std::size_t count)
+{
+    if (m_fd < 0) return false;
+
+    std::vector<iovec> vectors;
+    vectors.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (chunks[i].size > 0) {
+            vectors.push_back({ const_cast<char*>(chunks[i].data), chunks[i].size });
+        }
+    }
+
+    iovec* next = vectors.data();
+    std::size_t remaining = vectors.size();
+    while (remaining > 0) {
+        const ssize_t written = ::writev(m_fd, next, static_cast<int>(remaining < IOV_MAX ? remaining : IOV_MAX));
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        m_size += written;
+
+        std::size_t consumed = static_cast<std::size_t>(written);
+        while (remaining > 0 && consumed >= next->iov_len) {
+            consumed -= next->iov_len;
+            ++next;
+            --remaining;
+        }
+        if (remaining > 0) {
+            next->iov_base = static_cast<char*>(next->iov_base) + consumed;
+            next->iov_len -= consumed;
+        }
+    }
+    return true;
+}
+
+#else
+
+bool LogFile::open(const std::string& path)
+{
+    close();
+    m_path = path;
+    m_file = std::fopen(path.c_str(), "ab");
+    if (!m_file) return false;
+
+    std::fseek(m_file, 0, SEEK_END);
+    const long position = std::ftell(m_file);
+    m_size = position > 0 ? position : 0;
+    return true;
+}
+
+void LogFile::close()
+{
+    if (m_file) {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool LogFile::isOpen() const
+{
+    return m_file != nullptr;
+}
+
+bool LogFile::append(const Chunk* chunks, std::size_t count)
+{
+    if (!m_file) return false;
+
+    bool ok = true;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t written = std::fwrite(chunks[i].data, 1, chunks[i].size, m_file);
+        m_size += static_cast<std::int64_t>(written);
+        ok = ok && written == chunks[i].size;
+    }
+    return std::fflush(m_file) == 0 && ok;
+}
+
+#endif
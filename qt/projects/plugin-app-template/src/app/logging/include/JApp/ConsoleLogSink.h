@@ -0,0 +1,16 @@
+#pragma once
+
+#include "JApp/LogSink.h"
+
+namespace JApp {
+
+// Human-readable records on stdout, critical and fatal ones on stderr.
+class ConsoleLogSink : public ILogSink
+{
+public:
+    void write(const LogRecord& record) override;
+    const char* name() const override { return "console"; }
+    void flush() override;
+};
+
+}
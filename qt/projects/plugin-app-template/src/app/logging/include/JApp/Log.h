@@ -1,9 +1,18 @@
 #pragma once
 
 #include "JApp/Internal/LogUtils.h"
-#include <QLoggingCategory>
+#include "JApp/Internal/LogCategoryRegistry.h"
+#include "JApp/LogCallSite.h"
+#include "JApp/LogCategory.h"
+#include "JApp/LogStream.h"
 #include <QDebug>
 
+// Lowest level compiled in: 0 debug, 1 info, 2 warning, 3 critical.
+// Statements below it expand to dead code and their arguments are never evaluated.
+#ifndef JAPP_LOG_MIN_LEVEL
+#define JAPP_LOG_MIN_LEVEL 0
+#endif
+
 #define CATEGORY_NAME_FROM_PATH() \
     []() { \
             static constexpr auto name = JApp::Internal::LogUtils::categoryNameFromPath(__FILE__); \
@@ -11,13 +20,70 @@
             return str; \
     }()
 
+// Runtime level of this file's category, see Logger::setCategoryRules().
 #define CURRENT_LOG_CATEGORY() \
-    []() -> const QLoggingCategory& { \
-            static const QLoggingCategory category(CATEGORY_NAME_FROM_PATH()); \
+    []() -> const JApp::LogCategory& { \
+            static const JApp::LogCategory& category = \
+                JApp::Internal::LogCategoryRegistry::instance().category(CATEGORY_NAME_FROM_PATH()); \
             return category; \
     }()
 
-#define LOG_DEBUG()    qCDebug(CURRENT_LOG_CATEGORY())
-#define LOG_INFO()     qCInfo(CURRENT_LOG_CATEGORY())
-#define LOG_WARN()     qCWarning(CURRENT_LOG_CATEGORY())
-#define LOG_CRITICAL() qCCritical(CURRENT_LOG_CATEGORY())
+#define CURRENT_LOG_CALL_SITE() \
+    [](const char* function) -> JApp::LogCallSite& { \
+            static JApp::LogCallSite site { CATEGORY_NAME_FROM_PATH(), __FILE__, function, __LINE__ }; \
+            return site; \
+    }(Q_FUNC_INFO)
+
+// Runs the statement that follows once if the level passes, before anything of it is evaluated.
+#define JAPP_LOG_GATE(level) \
+    for (JApp::LogStatement japp_log { &CURRENT_LOG_CATEGORY(), nullptr }; \
+         japp_log.category && japp_log.category->isEnabled(static_cast<int>(level)) \
+             && japp_log.admit(CURRENT_LOG_CALL_SITE(), static_cast<int>(level)); \
+         japp_log.category = nullptr)
+
+#define JAPP_LOG(level) \
+    JAPP_LOG_GATE(level) JApp::LogStream(*japp_log.category, *japp_log.site, level).stream()
+
+// LOG_INFO_F("x={} y={}", x, y): arguments are captured as is and only formatted by
+// the outputs that write the record. The format must be a string literal: the "" prefix
+// makes anything else, such as a local char array, fail to compile.
+#define JAPP_LOG_F(level, ...) \
+    JAPP_LOG_GATE(level) JApp::logFormatted(*japp_log.category, *japp_log.site, level, "" __VA_ARGS__)
+
+#define JAPP_LOG_DISABLED() \
+    while (false) QMessageLogger().noDebug()
+
+#define JAPP_LOG_F_DISABLED(...) \
+    while (false) JApp::logDiscarded("" __VA_ARGS__)
+
+#if JAPP_LOG_MIN_LEVEL <= 0
+#define LOG_DEBUG()         JAPP_LOG(JApp::Logger::LogLevel::Debug)
+#define LOG_DEBUG_F(...)    JAPP_LOG_F(JApp::Logger::LogLevel::Debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG()         JAPP_LOG_DISABLED()
+#define LOG_DEBUG_F(...)    JAPP_LOG_F_DISABLED(__VA_ARGS__)
+#endif
+
+#if JAPP_LOG_MIN_LEVEL <= 1
+#define LOG_INFO()          JAPP_LOG(JApp::Logger::LogLevel::Info)
+#define LOG_INFO_F(...)     JAPP_LOG_F(JApp::Logger::LogLevel::Info, __VA_ARGS__)
+#else
+#define LOG_INFO()          JAPP_LOG_DISABLED()
+#define LOG_INFO_F(...)     JAPP_LOG_F_DISABLED(__VA_ARGS__)
+#endif
+
+#if JAPP_LOG_MIN_LEVEL <= 2
+#define LOG_WARN()          JAPP_LOG(JApp::Logger::LogLevel::Warning)
+#define LOG_WARN_F(...)     JAPP_LOG_F(JApp::Logger::LogLevel::Warning, __VA_ARGS__)
+#else
+#define LOG_WARN()          JAPP_LOG_DISABLED()
+#define LOG_WARN_F(...)     JAPP_LOG_F_DISABLED(__VA_ARGS__)
+#endif
+
+#if JAPP_LOG_MIN_LEVEL <= 3
+#define LOG_CRITICAL()      JAPP_LOG(JApp::Logger::LogLevel::Critical)
+#define LOG_CRITICAL_F(...) JAPP_LOG_F(JApp::Logger::LogLevel::Critical, __VA_ARGS__)
+#else
+#define LOG_CRITICAL()      JAPP_LOG_DISABLED()
+#define LOG_CRITICAL_F(...) JAPP_LOG_F_DISABLED(__VA_ARGS__)
+#endif
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QByteArray>
+#include <QDebug>
+#include <QLatin1String>
+#include <QString>
+#include <QStringView>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace JApp {
+
+// One argument of a LOG_*_F() statement, captured by value at the call site and
+// formatted only when an output consumes the record. Numbers are kept as is and strings
+// are shared, other types are streamed to QDebug right away.
+struct LogArgument {
+    enum class Type : quint8 {
+        Bool,
+        Char,
+        Int,
+        UInt,
+        Double,
+        Pointer,
+        String
+    };
+
+    Type type = Type::String;
+    union {
+        bool boolean;
+        char character;
+        qint64 integer;
+        quint64 unsignedInteger;
+        double floatingPoint;
+        const void* pointer;
+    };
+    QString string;
+
+    LogArgument() : integer(0) {}
+
+    template <typename T>
+    static LogArgument from(const T& value) {
+        using V = std::decay_t<T>;
+        LogArgument argument;
+        if constexpr (std::is_same_v<V, bool>) {
+            argument.type = Type::Bool;
+            argument.boolean = value;
+        } else if constexpr (std::is_same_v<V, char>) {
+            argument.type = Type::Char;
+            argument.character = value;
+        } else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>) {
+            argument.type = Type::Int;
+            argument.integer = value;
+        } else if constexpr (std::is_integral_v<V>) {
+            argument.type = Type::UInt;
+            argument.unsignedInteger = value;
+        } else if constexpr (std::is_floating_point_v<V>) {
+            argument.type = Type::Double;
+            argument.floatingPoint = value;
+        } else if constexpr (std::is_same_v<V, const char*> || std::is_same_v<V, char*>) {
+            argument.string = QString::fromUtf8(value);
+        } else if constexpr (std::is_same_v<V, QString>) {
+            argument.string = value;
+        } else if constexpr (std::is_same_v<V, QStringView> || std::is_same_v<V, QLatin1String>) {
+            argument.string = value.toString();
+        } else if constexpr (std::is_same_v<V, QByteArray>) {
+            argument.string = QString::fromUtf8(value);
+        } else if constexpr (std::is_same_v<V, std::string>) {
+            argument.string = QString::fromStdString(value);
+        } else if constexpr (std::is_pointer_v<V>) {
+            argument.type = Type::Pointer;
+            argument.pointer = value;
+        } else {
+            QDebug(&argument.string).noquote().nospace() << value;
+        }
+        return argument;
+    }
+};
+
+using LogArguments = std::vector<LogArgument>;
+
+}
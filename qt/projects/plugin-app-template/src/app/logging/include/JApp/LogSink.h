@@ -0,0 +1,39 @@
+#pragma once
+
+#include "JApp/Logger.h"
+#include <QString>
+
+namespace JApp {
+
+// Record handed to sinks. The logger formats the text once and shares the record between sinks.
+struct LogRecord {
+    Logger::Log log;
+    QString text; // Logger::formatLog() output, without line break
+};
+
+// Destination registered with Logger::addSink(). A sink is never called concurrently:
+// asynchronous sinks run on their own thread, synchronous ones under their own mutex.
+// Sinks must not log themselves.
+class ILogSink
+{
+public:
+    virtual ~ILogSink() = default;
+
+    virtual void write(const LogRecord& record) = 0;
+
+    // Label of the sink in Logger::stats() and the metrics file.
+    virtual const char* name() const { return "custom"; }
+
+    // Called after each batch of records and periodically by the logger.
+    virtual void flush() {}
+};
+
+struct LogSinkOptions {
+    LogSinkOptions(){}
+    Logger::LogLevel minLevel = Logger::LogLevel::Debug;
+    bool asynchronous         = true; // Own queue and thread, so a slow sink can't stall the others
+    int queueCapacity         = 4096;
+    Logger::OverflowPolicy overflowPolicy = Logger::OverflowPolicy::DropNewest;
+};
+
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "JApp/LogArgument.h"
+#include "JApp/LogCallSite.h"
+#include "JApp/LogCategory.h"
+#include "JApp/Internal/LogRateLimiter.h"
+#include "JApp/Logger.h"
+#include <QDebug>
+#include <QString>
+#include <cstddef>
+#include <utility>
+
+namespace JApp {
+
+// State of one LOG_*() statement while its gate is evaluated: category level first,
+// then the call site rate limit, all before any message is built.
+struct LogStatement {
+    const LogCategory* category;
+    LogCallSite* site;
+
+    bool admit(LogCallSite& callSite, int level) {
+        site = &callSite;
+        const int perSecond = category->rateLimit.load(std::memory_order_relaxed);
+        // Statements only kept by the crash log never reach the outputs, nor their suppression reports
+        return perSecond <= 0
+            || !category->isOutputEnabled(level)
+            || Internal::LogRateLimiter::acquire(callSite, level, perSecond,
+                                                 category->rateBurst.load(std::memory_order_relaxed));
+    }
+};
+
+// Collects one LOG_*() statement and hands it to the Logger with its call site id,
+// without going through qInstallMessageHandler and its per-message string copies.
+class LogStream
+{
+public:
+    LogStream(const LogCategory& category, LogCallSite& site, Logger::LogLevel level);
+    ~LogStream();
+
+    LogStream(const LogStream&) = delete;
+    LogStream& operator=(const LogStream&) = delete;
+
+    QDebug& stream() { return m_debug; }
+
+private:
+    const LogCategory& m_category;
+    LogCallSite& m_site;
+    Logger::LogLevel m_level;
+    QString m_message;
+    QDebug m_debug;
+};
+
+// Hands a LOG_*_F() statement to the Logger with its arguments captured, formatting is
+// left to the outputs. The format must be a string literal: only its address is kept.
+template <std::size_t N, typename... Args>
+void logFormatted(const LogCategory& category, LogCallSite& site, Logger::LogLevel level,
+                  const char (&format)[N], const Args&... arguments)
+{
+    LogArguments captured;
+    captured.reserve(sizeof...(Args));
+    (captured.push_back(LogArgument::from(arguments)), ...);
+    Logger::instance().log(category, site, level, format, std::move(captured));
+}
+
+// Type checks a compiled out LOG_*_F() statement.
+template <std::size_t N, typename... Args>
+void logDiscarded(const char (&)[N], const Args&...)
+{
+}
+
+}
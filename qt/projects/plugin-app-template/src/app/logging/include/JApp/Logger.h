@@ -1,22 +1,46 @@
 #pragma once
 
-#include <QObject>
 #include <QMutex>
+#include <QReadWriteLock>
 #include <QFile>
 #include <QTextStream>
 #include <QDateTime>
 #include <QDir>
 #include <QStandardPaths>
 #include <QLoggingCategory>
-#include <QTimer>
+#include <QThreadPool>
+#include <QHash>
+#include <QByteArray>
+#include <QList>
+#include "JApp/LogArgument.h"
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace JApp {
 
-class Logger : public QObject
-{
-    Q_OBJECT
+struct LogCallSite;
+struct LogCategory;
+class ILogSink;
+struct LogSinkOptions;
+
+namespace Internal {
+    template <typename T>
+    class LogQueue;
+    class MappedLogFile;
+    class LogFile;
+    class LogSinkChannel;
+    struct LogMetrics;
+    struct ThreadLogBuffer;
+}
 
+// Qt side of the logging library. Not a QObject: it needs no event loop, records are
+// written by its own threads, so any thread can log.
+class Logger
+{
 public:
     enum class LogLevel {
         Debug    = 0,
@@ -27,35 +51,118 @@ public:
     };
 
     enum class OutputTarget {
-        Console = 0x01,
+        Console = 0x01, // Through a ConsoleLogSink with its own queue, blocking when full
         File    = 0x02,
-        Both    = Console | File
+        Both    = Console | File,
+        BinaryFile = 0x04, // Compact records, decoded with japp-logcat
+        MappedFile = 0x08  // Text records copied into a memory-mapped segment
+    };
+
+    // What an asynchronous producer does when the queue is full.
+    enum class OverflowPolicy {
+        Block,      // Wait for the writer thread to make room
+        DropNewest, // Discard the record being logged
+        DropOldest  // Discard the oldest queued record
+    };
+
+    // How record timestamps are printed in text output.
+    enum class TimestampFormat {
+        Local,            // 2024-05-01 14:03:27.123, local time
+        Rfc3339,          // 2024-05-01T12:03:27.123456Z, UTC
+        EpochNanoseconds  // 1714564407123456789
+    };
+
+    // Record layout of the text log files (File and MappedFile targets). Console output stays text.
+    enum class FileFormat {
+        Text,      // Same " | " separated lines as the console, .log files
+        JsonLines  // One JSON object per line, .jsonl files
+    };
+
+    // How rotated log files are archived.
+    enum class Compression {
+        None,
+        Gzip, // Requires zlib at build time
+        Zstd  // Requires libzstd at build time
     };
 
     struct LogConfig {
         LogConfig(){}
         LogLevel minLevel     = LogLevel::Debug;
+        LogLevel consoleMinLevel = LogLevel::Debug;
+        LogLevel fileMinLevel = LogLevel::Debug; // File, MappedFile and BinaryFile outputs
         OutputTarget target   = OutputTarget::Both;
         QString logDirectory;
         QString logFilePrefix = "japp";
         qint64 maxFileSize    = 10 * 1024 * 1024; // 10MB
-        int maxFileCount      = 5;
+        int maxFileCount      = 5; // Per output file type, including the active file
+        Compression compression = Compression::None;
+        FileFormat fileFormat = FileFormat::Text;
         bool enableTimestamp  = true;
+        TimestampFormat timestampFormat = TimestampFormat::Local;
         bool enableCategory   = true;
         bool enableFunction   = true;
         bool enableLineNumber = true;
         bool enableThreadId   = true;
         int flushIntervalMs   = 1000;
+        int threadBufferSize  = 64 * 1024; // Per-thread staging for File output, 0 writes each record directly
+        bool asynchronous     = false;
+        int queueCapacity     = 8192;
+        OverflowPolicy overflowPolicy = OverflowPolicy::Block;
+        // Per-category levels, e.g. "models.*=warn;app=debug". Applied after minLevel, then
+        // categoryRulesFile (one rule per line, '#' comments), then the JAPP_LOG_RULES variable.
+        QString categoryRules;
+        QString categoryRulesFile;
+        // Per-category rate limits, records per second and call site with an optional burst,
+        // e.g. "models.*=20;app=5:50". Followed by the JAPP_LOG_RATE_LIMITS variable.
+        QString rateLimits;
+        // Keeps the last records at or above crashLogLevel in memory, whatever the levels above,
+        // and writes them to a .crash file on SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL or qFatal().
+        // Messages at that level are built even in categories that don't output them, so Debug
+        // costs every LOG_DEBUG() statement its message.
+        bool crashLog         = true;
+        LogLevel crashLogLevel = LogLevel::Info;
+        // Prometheus text file with the logger's own metrics (for a textfile collector), off when empty
+        QString metricsFile;
+        int metricsIntervalMs = 15000;
+        // Chrome trace of the TRACE_*() spans, written at shutdown when tracing is compiled in
+        QString traceFile;
+    };
+
+    // Latency distribution in stats(), in nanoseconds.
+    struct Histogram {
+        QList<qint64> bounds;   // Upper bound of each bucket
+        QList<quint64> counts;  // Cumulative count per bound, plus one last entry for all records
+        quint64 sum = 0;
+    };
+
+    struct OutputStats {
+        QString name;           // "file", "mapped_file", "binary_file" or the sink name
+        quint64 records = 0;
+        quint64 bytes = 0;      // Text length for sinks
+    };
+
+    struct Stats {
+        quint64 recordsPerLevel[5] = {}; // Indexed by LogLevel
+        QHash<QString, quint64> recordsPerCategory;
+        QList<OutputStats> outputs;
+        Histogram mutexHold;
+        Histogram flushLatency;
+        quint64 rotations = 0;
+        quint64 dropped = 0;
+        quint64 suppressed = 0;  // By rate limits
     };
 
     struct Log {
-        QDateTime timestamp;
-        QString   category;
+        qint64    timestamp; // Internal::LogClock ticks, converted to wall time when written
+        quint32   callSite; // Id in the call site registry (category, file, function, line)
         LogLevel  level;
-        QString   file;
-        QString   function;
-        int       line;
         QString   message;
+        quintptr  threadId;
+        quint64   sequence = 0; // Order in which the logger received the record
+        // LOG_*_F() records keep their format and arguments, and an empty message,
+        // until an output consumes them
+        const char* format = nullptr;
+        LogArguments arguments;
     };
 
     static Logger& instance();
@@ -64,34 +171,136 @@ public:
     void shutdown();
     
     void setLogLevel(LogLevel level);
+    void setCategoryLevel(const QString& pattern, LogLevel level);
+    bool setCategoryRules(const QString& rules);
+    bool loadCategoryRules(const QString& filePath);
+    void setRateLimit(const QString& pattern, int perSecond, int burst = 0);
+    bool setRateLimits(const QString& rules);
     void setOutputTarget(OutputTarget target);
     void setLogDirectory(const QString& directory);
 
-private slots:
-    void flushLogs();
+    // Sinks receive the records at or above their level, see LogSink.h. shutdown() removes them.
+    void addSink(std::shared_ptr<ILogSink> sink);
+    void addSink(std::shared_ptr<ILogSink> sink, const LogSinkOptions& options);
+    void removeSink(const std::shared_ptr<ILogSink>& sink);
+
+    quint64 droppedLogCount() const;
+    Stats stats() const;
+
+    // Entry point of the LOG_*() macros.
+    void log(const LogCategory& category, LogCallSite& site, LogLevel level, QString&& message);
+    void log(const LogCategory& category, LogCallSite& site, LogLevel level, const char* format, LogArguments&& arguments);
+
+    static QString levelToString(LogLevel level);
 
 private:
-    explicit Logger(QObject* parent = nullptr);
+    Logger();
     ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
     
     void setupMessageHandler();
+    void setupCrashLog();
+    void openLogFile();
     void rotateLogFile();
-    QString formatLog(const Log& log);
-    void handleLog(const Log& log);
-    QString levelToString(LogLevel level);
-    QString createLogFilePath();
+    void rotateBinaryLogFile();
+    void openMappedLogFile(qint64 minimumSize);
+    void rotateMappedLogFile(qint64 minimumSize);
+    void writeMappedLog(const QByteArray& line);
+    void archiveLogFile(const QString& path, const QString& extension);
+    QString formatLog(const Log& log, const LogConfig& config);
+    QString formatTimestamp(qint64 timestamp, const LogConfig& config) const;
+    void formatJsonLog(const Log& log, QByteArray& out) const;
+    QString textLogExtension() const;
+    void submitLog(const LogCategory& category, LogCallSite& site, Log&& log);
+    void handleLog(Log&& log);
+    void writeLog(Log& log);
+    void updateOutputLevel();
+    void publishConfig();
+    std::shared_ptr<const LogConfig> outputConfig() const;
+    void addConsoleSink();
+    void writeSinks(const Log& log, const QString& text);
+    void flushSinks();
+    void removeAllSinks();
+    void enqueueLog(Log&& log);
+    void writeFatalLog(Log&& log);
+    void startWriterThread();
+    void stopWriterThread();
+    void writerLoop();
+    void startFlusherThread();
+    void stopFlusherThread();
+    void flusherLoop();
+    void flushLogs();
+    void reportSuppressedLogs();
+    void writeMetricsFile();
+    Internal::ThreadLogBuffer& threadLogBuffer(const LogConfig& config);
+    void bufferLogLine(const QByteArray& line, bool flushNow, const LogConfig& config);
+    void writeLogFile(const QByteArray* const* chunks, size_t count);
+    QString createLogFilePath(const QString& extension = "log");
+    void openBinaryLogFile();
+    void writeBinaryLog(const Log& log);
+    quint32 internString(const char* string);
     void ensureLogDirectory();
 
     static void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message);
+    static void compressLogFile(const QString& path, Compression compression);
+    static void pruneLogFiles(const QString& directory, const QString& nameFilter, int maxFileCount);
     static LogLevel qtMsgTypeToLogLevel(QtMsgType type);
+    static QtMsgType logLevelToQtMsgType(LogLevel level);
 
 private:
-    bool m_initialized;
+    std::atomic<bool> m_initialized; // Read by every logging thread
     LogConfig m_config;
-    std::unique_ptr<QFile> m_logFile;
-    std::unique_ptr<QTextStream> m_logStream;
-    QMutex m_mutex;
-    QTimer* m_flushTimer;
+    std::shared_ptr<const LogConfig> m_outputConfig; // Copy of m_config for the logging threads, see publishConfig()
+    std::unique_ptr<Internal::LogFile> m_logFile;
+    QMutex m_mutex; // m_config, unbuffered File and BinaryFile writes, rotations, m_consoleSink
+
+    // Per-thread staging of File output, flushed by the owner or the flusher thread
+    std::mutex m_threadBuffersMutex;
+    std::vector<std::shared_ptr<Internal::ThreadLogBuffer>> m_threadBuffers;
+    std::thread m_flusherThread;
+    std::atomic<bool> m_flusherRunning;
+    std::mutex m_flusherMutex;
+    std::condition_variable m_flusherCondition;
+
+    // Memory-mapped output: appends share the lock, rotation takes it exclusively
+    std::unique_ptr<Internal::MappedLogFile> m_mappedLogFile;
+    QReadWriteLock m_mappedLogLock;
+
+    // Compression and pruning of rotated files, off the logging path
+    QThreadPool m_archivePool;
+
+    // Binary output
+    std::unique_ptr<QFile> m_binaryLogFile;
+    qint64 m_binaryLogFileBytes;
+    QHash<const char*, quint32> m_internedStrings;
+    QByteArray m_binaryBuffer;
+
+    // Sinks: records fan out under the shared lock, registration takes it exclusively
+    std::vector<std::unique_ptr<Internal::LogSinkChannel>> m_sinks;
+    std::shared_ptr<ILogSink> m_consoleSink;
+    mutable QReadWriteLock m_sinksLock;
+
+    // Self-metrics, see stats()
+    std::unique_ptr<Internal::LogMetrics> m_metrics;
+
+    // Asynchronous mode
+    std::unique_ptr<Internal::LogQueue<Log>> m_queue;
+    std::atomic<bool> m_queueOpen;      // Cleared before the queue is freed, producers then write synchronously
+    std::atomic<int> m_queueProducers;  // Producers between checking m_queueOpen and leaving the queue
+    // Sequences of the Fatal records written by the writer thread, waited for by writeFatalLog()
+    std::mutex m_fatalLogsMutex;
+    std::condition_variable m_fatalLogsCondition;
+    std::vector<quint64> m_fatalLogsWritten;
+    std::thread m_writerThread;
+    std::atomic<bool> m_writerRunning;
+    std::atomic<bool> m_writerSleeping;
+    std::mutex m_writerMutex;
+    std::condition_variable m_writerCondition;
+    std::atomic<quint64> m_droppedLogCount;
+    std::atomic<quint64> m_sequence;
+
     static Logger* s_instance;
 };
 
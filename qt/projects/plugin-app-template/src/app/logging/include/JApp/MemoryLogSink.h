@@ -0,0 +1,30 @@
+#pragma once
+
+#include "JApp/LogSink.h"
+#include <QList>
+#include <mutex>
+#include <vector>
+
+namespace JApp {
+
+// Keeps the most recent records in memory, e.g. for an in-app log view or a bug report.
+class MemoryLogSink : public ILogSink
+{
+public:
+    explicit MemoryLogSink(int capacity = 1000);
+
+    void write(const LogRecord& record) override;
+    const char* name() const override { return "memory"; }
+
+    // Oldest first.
+    QList<LogRecord> records() const;
+    void clear();
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<LogRecord> m_records;
+    size_t m_capacity;
+    size_t m_next;
+};
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "JApp/LogSink.h"
+#include <QByteArray>
+#include <QString>
+
+namespace JApp {
+
+// Sends records as syslog datagrams ("<PRI>identity[pid]: category: message") to a local
+// Unix socket, /dev/log by default. Only available on Unix; elsewhere records are discarded.
+class SyslogLogSink : public ILogSink
+{
+public:
+    // Facility as defined by syslog: 1 user, 16 to 23 local0 to local7.
+    explicit SyslogLogSink(const QString& socketPath = "/dev/log",
+                           const QString& identity = QString(),
+                           int facility = 1);
+    ~SyslogLogSink() override;
+
+    SyslogLogSink(const SyslogLogSink&) = delete;
+    SyslogLogSink& operator=(const SyslogLogSink&) = delete;
+
+    void write(const LogRecord& record) override;
+    const char* name() const override { return "syslog"; }
+
+private:
+    bool connectSocket();
+    void closeSocket();
+
+    static int severity(Logger::LogLevel level);
+
+    QByteArray m_socketPath;
+    QByteArray m_tag; // "identity[pid]: "
+    int m_facility;
+    int m_socket;
+    QByteArray m_datagram;
+};
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "JApp/Log.h"
+
+// Tracing is compiled in with JAPP_TRACING=1 (CMake option JAPP_ENABLE_TRACING).
+// Otherwise the macros expand to nothing and their arguments are never evaluated.
+#ifndef JAPP_TRACING
+#define JAPP_TRACING 0
+#endif
+
+#if JAPP_TRACING
+
+#include "JApp/Tracer.h"
+
+#define JAPP_TRACE_CONCAT_IMPL(a, b) a##b
+#define JAPP_TRACE_CONCAT(a, b) JAPP_TRACE_CONCAT_IMPL(a, b)
+
+// Traces the enclosing scope under this file's category. name must be a string literal.
+#define TRACE_SCOPE(name) \
+    const JApp::TraceScope JAPP_TRACE_CONCAT(japp_trace_scope_, __LINE__)(CATEGORY_NAME_FROM_PATH(), name)
+
+// Spans that don't follow a scope. Each TRACE_BEGIN() needs a TRACE_END() on the same thread.
+#define TRACE_BEGIN(name) JApp::Tracer::instance().begin(CATEGORY_NAME_FROM_PATH(), name)
+#define TRACE_END(name)   JApp::Tracer::instance().end(CATEGORY_NAME_FROM_PATH(), name)
+
+#else
+
+#define TRACE_SCOPE(name) static_cast<void>(0)
+#define TRACE_BEGIN(name) static_cast<void>(0)
+#define TRACE_END(name)   static_cast<void>(0)
+
+#endif
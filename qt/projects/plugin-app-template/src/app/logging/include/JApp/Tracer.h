@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace JApp {
+
+namespace Internal {
+    struct ThreadTraceBuffer;
+}
+
+// Collects trace events in per-thread buffers and exports them as Chrome Trace Event JSON,
+// readable by chrome://tracing and Perfetto. Fed by the TRACE_*() macros of Trace.h.
+// Category and event names must be string literals: only the pointers are stored.
+class Tracer
+{
+public:
+    static Tracer& instance();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    void begin(const char* category, const char* name);
+    void end(const char* category, const char* name);
+
+    // One event spanning [start, end], in Internal::LogClock ticks.
+    void complete(const char* category, const char* name, qint64 start, qint64 end);
+
+    bool exportChromeTrace(const QString& filePath);
+    void clear();
+
+    // Events lost because a thread's buffer was full.
+    quint64 droppedEventCount() const;
+
+private:
+    Tracer() = default;
+
+    void record(const char* category, const char* name, char phase, qint64 timestamp, qint64 duration);
+    Internal::ThreadTraceBuffer& threadBuffer();
+
+    std::atomic<bool> m_enabled { true };
+    std::atomic<quint64> m_droppedEventCount { 0 };
+    std::mutex m_buffersMutex;
+    std::vector<std::shared_ptr<Internal::ThreadTraceBuffer>> m_buffers;
+};
+
+// Records one complete event for the lifetime of the scope, see TRACE_SCOPE().
+class TraceScope
+{
+public:
+    TraceScope(const char* category, const char* name);
+    ~TraceScope();
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_category;
+    const char* m_name;
+    qint64 m_start;
+};
+
+}
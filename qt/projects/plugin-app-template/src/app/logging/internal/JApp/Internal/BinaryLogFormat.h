@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QByteArray>
+#include <QtEndian>
+#include <cstring>
+
+// Layout of the binary log files written by OutputTarget::BinaryFile and read by japp-logcat.
+// All integers are little-endian. A file is a FileHeader followed by a sequence of records,
+// each starting with a one-byte RecordType. Strings (categories, functions, files) are
+// interned: a String record defines an id once, then Log records refer to it.
+namespace JApp {
+    namespace Internal {
+        namespace BinaryLogFormat {
+            constexpr char Magic[4] = { 'J', 'L', 'O', 'G' };
+            constexpr quint16 Version = 1;
+
+            enum class RecordType : quint8 {
+                String = 1,
+                Log    = 2
+            };
+
+            // magic[4] | version u16 | headerSize u16 | ticksPerSecond u64
+            constexpr int FileHeaderSize = 16;
+
+            // type u8 | id u32 | size u32 | utf8[size]
+            constexpr int StringHeaderSize = 9;
+
+            // type u8 | level u8 | timestamp i64 | category u32 | function u32 | file u32
+            // | line i32 | thread u64 | payloadSize u32 | utf8[payloadSize]
+            constexpr int LogHeaderSize = 38;
+
+            // Timestamps are nanoseconds since the Unix epoch. Readers must honour the
+            // ticksPerSecond of the file header, older files use milliseconds.
+            constexpr quint64 TicksPerSecond = 1000000000;
+
+            template <typename T>
+            inline void append(QByteArray& buffer, T value) {
+                const T le = qToLittleEndian(value);
+                buffer.append(reinterpret_cast<const char*>(&le), sizeof(T));
+            }
+
+            template <typename T>
+            inline T read(const char* data) {
+                T value;
+                std::memcpy(&value, data, sizeof(T));
+                return qFromLittleEndian(value);
+            }
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <QByteArray>
+#include <QStringView>
+#include <cstdint>
+
+// Minimal JSON writer for log records. It appends straight into a caller-owned buffer,
+// so a buffer reused across records makes escaping allocation-free.
+namespace JApp {
+    namespace Internal {
+        namespace JsonLogWriter {
+            namespace detail {
+                inline void appendEscapedAscii(QByteArray& out, char c) {
+                    static constexpr char Hex[] = "0123456789abcdef";
+                    switch (c) {
+                        case '"':  out.append("\\\"", 2); break;
+                        case '\\': out.append("\\\\", 2); break;
+                        case '\n': out.append("\\n", 2); break;
+                        case '\r': out.append("\\r", 2); break;
+                        case '\t': out.append("\\t", 2); break;
+                        default:
+                            if (static_cast<unsigned char>(c) < 0x20) {
+                                const char escaped[] = { '\\', 'u', '0', '0', Hex[(c >> 4) & 0xF], Hex[c & 0xF] };
+                                out.append(escaped, sizeof(escaped));
+                            } else {
+                                out.append(c);
+                            }
+                    }
+                }
+
+                inline void appendUtf8(QByteArray& out, char32_t codePoint) {
+                    if (codePoint < 0x80) {
+                        appendEscapedAscii(out, static_cast<char>(codePoint));
+                    } else if (codePoint < 0x800) {
+                        out.append(static_cast<char>(0xC0 | (codePoint >> 6)));
+                        out.append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+                    } else if (codePoint < 0x10000) {
+                        out.append(static_cast<char>(0xE0 | (codePoint >> 12)));
+                        out.append(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                        out.append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+                    } else {
+                        out.append(static_cast<char>(0xF0 | (codePoint >> 18)));
+                        out.append(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+                        out.append(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+                        out.append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+                    }
+                }
+            }
+
+            // Appends a quoted string from UTF-8 text (call site strings are already UTF-8).
+            inline void appendString(QByteArray& out, const char* utf8) {
+                out.append('"');
+                for (const char* c = utf8; c && *c; ++c) {
+                    detail::appendEscapedAscii(out, *c);
+                }
+                out.append('"');
+            }
+
+            // Appends a quoted string, converting UTF-16 on the fly. Lone surrogates become U+FFFD.
+            inline void appendString(QByteArray& out, QStringView text) {
+                out.append('"');
+                const qsizetype size = text.size();
+                for (qsizetype i = 0; i < size; ++i) {
+                    const QChar c = text[i];
+                    char32_t codePoint = c.unicode();
+                    if (c.isHighSurrogate() && i + 1 < size && text[i + 1].isLowSurrogate()) {
+                        codePoint = QChar::surrogateToUcs4(c, text[++i]);
+                    } else if (c.isSurrogate()) {
+                        codePoint = 0xFFFD;
+                    }
+                    detail::appendUtf8(out, codePoint);
+                }
+                out.append('"');
+            }
+
+            inline void appendNumber(QByteArray& out, std::int64_t value) {
+                char digits[21];
+                int pos = sizeof(digits);
+                std::uint64_t magnitude = value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+                do {
+                    digits[--pos] = static_cast<char>('0' + magnitude % 10);
+                    magnitude /= 10;
+                } while (magnitude);
+                if (value < 0) {
+                    digits[--pos] = '-';
+                }
+                out.append(digits + pos, sizeof(digits) - pos);
+            }
+
+            inline void appendHexString(QByteArray& out, std::uint64_t value) {
+                static constexpr char Hex[] = "0123456789abcdef";
+                char digits[18];
+                int pos = sizeof(digits);
+                digits[--pos] = '"';
+                do {
+                    digits[--pos] = Hex[value & 0xF];
+                    value >>= 4;
+                } while (value);
+                digits[--pos] = '"';
+                out.append(digits + pos, sizeof(digits) - pos);
+            }
+
+            // Appends "key": for the next value, with a leading comma unless it is the first field.
+            inline void appendKey(QByteArray& out, const char* key, bool first = false) {
+                if (!first) {
+                    out.append(',');
+                }
+                appendString(out, key);
+                out.append(':');
+            }
+        }
+    }
+}
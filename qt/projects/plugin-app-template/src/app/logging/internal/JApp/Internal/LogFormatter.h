@@ -0,0 +1,21 @@
+#pragma once
+
+#include "JApp/LogArgument.h"
+#include <QString>
+#include <cstddef>
+
+namespace JApp {
+    namespace Internal {
+        // Formats LOG_*_F() records: each "{}" of the UTF-8 format string takes the next
+        // argument, "{{" and "}}" are literal braces. Placeholders without an argument are
+        // kept as is and extra arguments are ignored.
+        namespace LogFormatter {
+            QString format(const char* format, const LogArgument* arguments, std::size_t count);
+
+            // Same text into a fixed buffer, cut at capacity, without allocating.
+            // Returns the number of UTF-16 code units written.
+            std::size_t formatInto(char16_t* out, std::size_t capacity, const char* format,
+                                   const LogArgument* arguments, std::size_t count);
+        }
+    }
+}
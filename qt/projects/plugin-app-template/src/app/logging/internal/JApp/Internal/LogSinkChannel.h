@@ -0,0 +1,72 @@
+#pragma once
+
+#include "JApp/LogSink.h"
+#include "JApp/Internal/LogQueue.h"
+#include "JApp/Internal/LogMetrics.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace JApp {
+    namespace Internal {
+        // Connects the logger to one sink: level filter, and for asynchronous sinks a bounded
+        // queue drained by a dedicated thread. Calls into the sink are serialized by m_sinkMutex.
+        class LogSinkChannel {
+        public:
+            LogSinkChannel(std::shared_ptr<ILogSink> sink, const LogSinkOptions& options,
+                           std::atomic<quint64>& droppedLogCount);
+            ~LogSinkChannel();
+
+            LogSinkChannel(const LogSinkChannel&) = delete;
+            LogSinkChannel& operator=(const LogSinkChannel&) = delete;
+
+            const std::shared_ptr<ILogSink>& sink() const {
+                return m_sink;
+            }
+
+            Logger::LogLevel minLevel() const {
+                return m_options.minLevel;
+            }
+
+            bool accepts(Logger::LogLevel level) const {
+                return level >= m_options.minLevel;
+            }
+
+            void post(const std::shared_ptr<const LogRecord>& record);
+
+            // Writes pending records and this one before returning, e.g. before a fatal abort.
+            void writeNow(const LogRecord& record);
+
+            void flush();
+
+            const LogOutputCounters& counters() const {
+                return m_counters;
+            }
+
+            // Drains the queue and joins the thread.
+            void stop();
+
+        private:
+            void run();
+            bool drain(); // Requires m_sinkMutex
+            void write(const LogRecord& record); // Requires m_sinkMutex
+
+            using Record = std::shared_ptr<const LogRecord>;
+
+            std::shared_ptr<ILogSink> m_sink;
+            const LogSinkOptions m_options;
+            std::atomic<quint64>& m_droppedLogCount;
+            std::mutex m_sinkMutex;
+            LogOutputCounters m_counters;
+
+            std::unique_ptr<LogQueue<Record>> m_queue;
+            std::thread m_thread;
+            std::atomic<bool> m_running;
+            std::atomic<bool> m_sleeping;
+            std::mutex m_mutex;
+            std::condition_variable m_condition;
+        };
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <atomic>
+
+namespace JApp {
+    namespace Internal {
+        // Preallocated, memory-mapped log segment. Writers reserve space with an atomic
+        // fetch-add and copy into the mapping, so appending costs no system call. The file
+        // is truncated to the bytes actually written when closed; after a crash it keeps
+        // every completed record, followed by zero padding up to the segment size.
+        class MappedLogFile {
+        public:
+            MappedLogFile() = default;
+            ~MappedLogFile();
+
+            MappedLogFile(const MappedLogFile&) = delete;
+            MappedLogFile& operator=(const MappedLogFile&) = delete;
+
+            bool open(const QString& path, qint64 capacity);
+            void close();
+
+            // Thread-safe. Returns false when the segment cannot fit the data.
+            bool append(const char* data, qint64 size);
+
+            qint64 capacity() const { return m_capacity; }
+            qint64 length() const;
+            QString fileName() const { return m_file.fileName(); }
+
+        private:
+            QFile m_file;
+            uchar* m_data = nullptr;
+            qint64 m_capacity = 0;
+            std::atomic<qint64> m_reserved { 0 };
+            std::atomic<qint64> m_firstOverflow { 0 };
+        };
+    }
+}
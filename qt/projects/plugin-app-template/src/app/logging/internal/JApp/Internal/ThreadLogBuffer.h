@@ -0,0 +1,15 @@
+#pragma once
+
+#include <QByteArray>
+#include <mutex>
+
+namespace JApp {
+    namespace Internal {
+        // Formatted records staged by one thread before they reach the log file.
+        // The owning thread and the flusher thread are the only users of the mutex.
+        struct ThreadLogBuffer {
+            std::mutex mutex;
+            QByteArray data;
+        };
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QtGlobal>
+#include <mutex>
+#include <vector>
+
+namespace JApp {
+    namespace Internal {
+        struct TraceEvent {
+            const char* category;
+            const char* name;
+            qint64 timestamp; // Internal::LogClock ticks
+            qint64 duration;  // Complete events only
+            char phase;       // 'B', 'E' or 'X' as in the Chrome Trace Event format
+        };
+
+        // Events of one thread. The owning thread appends, exports copy under the mutex.
+        struct ThreadTraceBuffer {
+            static constexpr size_t MaxEvents = 256 * 1024;
+
+            std::mutex mutex;
+            std::vector<TraceEvent> events;
+            quint64 threadId = 0;
+        };
+    }
+}
@@ -0,0 +1,19 @@
+#include "JApp/ConsoleLogSink.h"
+#include <iostream>
+
+using namespace JApp;
+
+void ConsoleLogSink::write(const LogRecord& record)
+{
+    // Line breaks without flushing: the channel flushes once per batch
+    const QByteArray text = record.text.toUtf8();
+    std::ostream& stream = record.log.level >= Logger::LogLevel::Critical ? std::cerr : std::cout;
+    stream.write(text.constData(), text.size());
+    stream.put('\n');
+}
+
+void ConsoleLogSink::flush()
+{
+    std::cout.flush();
+    std::cerr.flush();
+}
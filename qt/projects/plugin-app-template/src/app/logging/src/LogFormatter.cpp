@@ -0,0 +1,176 @@
+#include "JApp/Internal/LogFormatter.h"
+#include <cstdio>
+
+using namespace JApp;
+using namespace JApp::Internal;
+
+namespace {
+
+class StringOutput
+{
+public:
+    explicit StringOutput(QString& text) : m_text(text) {}
+
+    void appendUtf8(const char* text, std::size_t size) {
+        m_text.append(QString::fromUtf8(text, static_cast<qsizetype>(size)));
+    }
+
+    void appendLatin1(const char* text, std::size_t size) {
+        m_text.append(QLatin1String(text, static_cast<qsizetype>(size)));
+    }
+
+    void appendString(const QString& text) {
+        m_text.append(text);
+    }
+
+private:
+    QString& m_text;
+};
+
+class BufferOutput
+{
+public:
+    BufferOutput(char16_t* out, std::size_t capacity) : m_out(out), m_capacity(capacity) {}
+
+    std::size_t size() const {
+        return m_size;
+    }
+
+    void appendUtf8(const char* text, std::size_t size) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(text);
+        for (std::size_t i = 0; i < size;) {
+            char32_t codePoint = bytes[i];
+            int length = 1;
+            if (codePoint >= 0xF0) {
+                codePoint &= 0x07;
+                length = 4;
+            } else if (codePoint >= 0xE0) {
+                codePoint &= 0x0F;
+                length = 3;
+            } else if (codePoint >= 0xC0) {
+                codePoint &= 0x1F;
+                length = 2;
+            } else if (codePoint >= 0x80) {
+                codePoint = 0xFFFD;
+            }
+            if (i + length > size) {
+                codePoint = 0xFFFD;
+                length = static_cast<int>(size - i);
+            } else {
+                for (int k = 1; k < length; ++k) {
+                    codePoint = (codePoint << 6) | (bytes[i + k] & 0x3F);
+                }
+            }
+            i += length;
+
+            if (codePoint >= 0x10000) {
+                append(static_cast<char16_t>(0xD800 + ((codePoint - 0x10000) >> 10)));
+                append(static_cast<char16_t>(0xDC00 + ((codePoint - 0x10000) & 0x3FF)));
+            } else {
+                append(static_cast<char16_t>(codePoint));
+            }
+        }
+    }
+
+    void appendLatin1(const char* text, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            append(static_cast<unsigned char>(text[i]));
+        }
+    }
+
+    void appendString(const QString& text) {
+        const char16_t* data = reinterpret_cast<const char16_t*>(text.utf16());
+        for (qsizetype i = 0; i < text.size(); ++i) {
+            append(data[i]);
+        }
+    }
+
+private:
+    void append(char16_t c) {
+        if (m_size < m_capacity) {
+            m_out[m_size++] = c;
+        }
+    }
+
+    char16_t* m_out;
+    std::size_t m_capacity;
+    std::size_t m_size = 0;
+};
+
+template <typename Output>
+void appendArgument(Output& out, const LogArgument& argument)
+{
+    char digits[32];
+    int length = 0;
+    switch (argument.type) {
+    case LogArgument::Type::Bool:
+        argument.boolean ? out.appendLatin1("true", 4) : out.appendLatin1("false", 5);
+        return;
+    case LogArgument::Type::Char:
+        out.appendLatin1(&argument.character, 1);
+        return;
+    case LogArgument::Type::Int:
+        length = std::snprintf(digits, sizeof(digits), "%lld", static_cast<long long>(argument.integer));
+        break;
+    case LogArgument::Type::UInt:
+        length = std::snprintf(digits, sizeof(digits), "%llu", static_cast<unsigned long long>(argument.unsignedInteger));
+        break;
+    case LogArgument::Type::Double:
+        // Same precision as QDebug
+        length = std::snprintf(digits, sizeof(digits), "%g", argument.floatingPoint);
+        break;
+    case LogArgument::Type::Pointer:
+        length = std::snprintf(digits, sizeof(digits), "0x%llx",
+                               static_cast<unsigned long long>(reinterpret_cast<quintptr>(argument.pointer)));
+        break;
+    case LogArgument::Type::String:
+        out.appendString(argument.string);
+        return;
+    }
+    if (length > 0) {
+        out.appendLatin1(digits, static_cast<std::size_t>(length));
+    }
+}
+
+template <typename Output>
+void render(Output& out, const char* format, const LogArgument* arguments, std::size_t count)
+{
+    if (!format) return;
+
+    std::size_t next = 0;
+    const char* literal = format;
+    const char* c = format;
+    while (*c) {
+        if ((c[0] == '{' && c[1] == '{') || (c[0] == '}' && c[1] == '}')) {
+            out.appendUtf8(literal, static_cast<std::size_t>(c - literal) + 1);
+            c += 2;
+            literal = c;
+        } else if (c[0] == '{' && c[1] == '}' && next < count) {
+            out.appendUtf8(literal, static_cast<std::size_t>(c - literal));
+            appendArgument(out, arguments[next++]);
+            c += 2;
+            literal = c;
+        } else {
+            ++c;
+        }
+    }
+    out.appendUtf8(literal, static_cast<std::size_t>(c - literal));
+}
+
+}
+
+QString LogFormatter::format(const char* format, const LogArgument* arguments, std::size_t count)
+{
+    QString text;
+    StringOutput out(text);
+    render(out, format, arguments, count);
+    return text;
+}
+
+std::size_t LogFormatter::formatInto(char16_t* out, std::size_t capacity, const char* format,
+                                     const LogArgument* arguments, std::size_t count)
+{
+    BufferOutput buffer(out, capacity);
+    render(buffer, format, arguments, count);
+    return buffer.size();
+}
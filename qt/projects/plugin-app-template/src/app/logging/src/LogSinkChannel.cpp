@@ -0,0 +1,138 @@
+#include "JApp/Internal/LogSinkChannel.h"
+
+using namespace JApp;
+using namespace JApp::Internal;
+
+LogSinkChannel::LogSinkChannel(std::shared_ptr<ILogSink> sink, const LogSinkOptions& options,
+                               std::atomic<quint64>& droppedLogCount)
+    : m_sink(std::move(sink))
+    , m_options(options)
+    , m_droppedLogCount(droppedLogCount)
+    , m_running(false)
+    , m_sleeping(false)
+{
+    if (m_options.asynchronous) {
+        m_queue = std::make_unique<LogQueue<Record>>(qMax(m_options.queueCapacity, 2));
+        m_running.store(true);
+        m_thread = std::thread(&LogSinkChannel::run, this);
+    }
+}
+
+LogSinkChannel::~LogSinkChannel()
+{
+    stop();
+}
+
+void LogSinkChannel::post(const std::shared_ptr<const LogRecord>& record)
+{
+    if (!m_queue) {
+        std::lock_guard<std::mutex> lock(m_sinkMutex);
+        write(*record);
+        return;
+    }
+
+    Record pending = record;
+    switch (m_options.overflowPolicy) {
+        case Logger::OverflowPolicy::Block:
+            while (!m_queue->tryPush(std::move(pending))) {
+                m_condition.notify_one();
+                std::this_thread::yield();
+            }
+            break;
+        case Logger::OverflowPolicy::DropNewest:
+            if (!m_queue->tryPush(std::move(pending))) {
+                m_droppedLogCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            break;
+        case Logger::OverflowPolicy::DropOldest: {
+            Record evicted;
+            while (!m_queue->tryPush(std::move(pending))) {
+                if (m_queue->tryPop(evicted)) {
+                    m_droppedLogCount.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            break;
+        }
+    }
+
+    // Same parking protocol as the logger's writer thread
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_condition.notify_one();
+    }
+}
+
+void LogSinkChannel::writeNow(const LogRecord& record)
+{
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    if (m_queue) {
+        drain();
+    }
+    write(record);
+    m_sink->flush();
+}
+
+void LogSinkChannel::flush()
+{
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    m_sink->flush();
+}
+
+void LogSinkChannel::stop()
+{
+    if (!m_thread.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running.store(false);
+    }
+    m_condition.notify_one();
+    m_thread.join();
+
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+    drain();
+    m_sink->flush();
+}
+
+void LogSinkChannel::write(const LogRecord& record)
+{
+    m_sink->write(record);
+    m_counters.add(static_cast<std::uint64_t>(record.text.size()) + 1);
+}
+
+bool LogSinkChannel::drain()
+{
+    // Bounded, so flushes and fatal records don't wait behind a busy producer
+    size_t count = 0;
+    Record record;
+    while (count < m_queue->capacity() && m_queue->tryPop(record)) {
+        write(*record);
+        ++count;
+    }
+    return count > 0;
+}
+
+void LogSinkChannel::run()
+{
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(m_sinkMutex);
+            if (drain()) {
+                m_sink->flush();
+                continue;
+            }
+        }
+
+        if (!m_running.load()) break;
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_queue->isEmpty() && m_running.load()) {
+            m_condition.wait_for(lock, std::chrono::seconds(1));
+        }
+        m_sleeping.store(false, std::memory_order_relaxed);
+    }
+}
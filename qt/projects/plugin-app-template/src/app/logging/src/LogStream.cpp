@@ -0,0 +1,20 @@
+#include "JApp/LogStream.h"
+
+using namespace JApp;
+
+LogStream::LogStream(const LogCategory& category, LogCallSite& site, Logger::LogLevel level)
+    : m_category(category)
+    , m_site(site)
+    , m_level(level)
+    , m_debug(&m_message)
+{
+}
+
+LogStream::~LogStream()
+{
+    // QDebug separates items with spaces, including after the last one
+    if (m_message.endsWith(QLatin1Char(' '))) {
+        m_message.chop(1);
+    }
+    Logger::instance().log(m_category, m_site, m_level, std::move(m_message));
+}
@@ -1,20 +1,229 @@
 #include "JApp/Logger.h"
-#include <QApplication>
+#include "JApp/ConsoleLogSink.h"
+#include "JApp/LogSink.h"
+#include "JApp/Internal/LogQueue.h"
+#include "JApp/Internal/BinaryLogFormat.h"
+#include "JApp/Internal/LogCallSiteRegistry.h"
+#include "JApp/Internal/LogCategoryRegistry.h"
+#include "JApp/Internal/LogClock.h"
+#include "JApp/Internal/CrashLogRing.h"
+#include "JApp/Internal/LogRateLimiter.h"
+#include "JApp/Internal/LogMetrics.h"
+#include "JApp/Internal/LogCompression.h"
+#include "JApp/Internal/LogFile.h"
+#include "JApp/Internal/JsonLogWriter.h"
+#include "JApp/Internal/LogFormatter.h"
+#include "JApp/Internal/MappedLogFile.h"
+#include "JApp/Internal/LogSinkChannel.h"
+#include "JApp/Internal/ThreadLogBuffer.h"
 #include <QThread>
 #include <QFileInfo>
+#include <QRegularExpression>
+#include <QSaveFile>
 #include <QDebug>
 #include <JApp/Log.h>
+#include <JApp/Trace.h>
+#include <JApp/Tracer.h>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <limits>
+
 
 using namespace JApp;
 
+namespace {
+
+// QMutexLocker that also records how long the mutex was held.
+class TimedMutexLocker {
+public:
+    TimedMutexLocker(QMutex* mutex, Internal::LogHistogram& histogram)
+        : m_mutex(mutex)
+        , m_histogram(histogram)
+    {
+        m_mutex->lock();
+        m_start = Internal::LogClock::now();
+    }
+
+    ~TimedMutexLocker() {
+        unlock();
+    }
+
+    void unlock() {
+        if (!m_mutex) return;
+        m_histogram.record(Internal::LogClock::now() - m_start);
+        m_mutex->unlock();
+        m_mutex = nullptr;
+    }
+
+private:
+    QMutex* m_mutex;
+    Internal::LogHistogram& m_histogram;
+    qint64 m_start;
+};
+
+Logger::Histogram toHistogram(const Internal::LogHistogram& histogram)
+{
+    Logger::Histogram result;
+    quint64 count = 0;
+    for (size_t bucket = 0; bucket < Internal::LogHistogram::BucketCount; ++bucket) {
+        count += histogram.bucketCount(bucket);
+        result.bounds.append(Internal::LogHistogram::bucketBound(bucket));
+        result.counts.append(count);
+    }
+    result.counts.append(count + histogram.bucketCount(Internal::LogHistogram::BucketCount));
+    result.sum = histogram.sum();
+    return result;
+}
+
+QString escapeLabel(const QString& value)
+{
+    QString escaped = value;
+    escaped.replace('\\', "\\\\").replace('"', "\\\"").replace('\n', "\\n");
+    return escaped;
+}
+
+void appendMetric(QString& out, const char* name, const char* type, const char* help)
+{
+    out += QString("# HELP %1 %2\n# TYPE %1 %3\n")
+               .arg(QLatin1String(name), QLatin1String(help), QLatin1String(type));
+}
+
+void appendHistogram(QString& out, const char* name, const char* help, const Logger::Histogram& histogram)
+{
+    appendMetric(out, name, "histogram", help);
+    for (int i = 0; i < histogram.bounds.size(); ++i) {
+        out += QString("%1_bucket{le=\"%2\"} %3\n").arg(name).arg(histogram.bounds[i] / 1e9, 0, 'g', 6).arg(histogram.counts[i]);
+    }
+    out += QString("%1_bucket{le=\"+Inf\"} %2\n").arg(name).arg(histogram.counts.last());
+    out += QString("%1_sum %2\n").arg(name).arg(histogram.sum / 1e9, 0, 'g', 12);
+    out += QString("%1_count %2\n").arg(name).arg(histogram.counts.last());
+}
+
+void captureCrashLog(const Logger::Log& log)
+{
+    Internal::CrashLogRing& ring = Internal::CrashLogRing::instance();
+    if (!ring.accepts(static_cast<int>(log.level))) return;
+
+    if (log.format) {
+        // The ring keeps a short prefix anyway, so format just that much on the stack
+        char16_t text[Internal::CrashLogRing::MessageSize];
+        const size_t size = Internal::LogFormatter::formatInto(text, Internal::CrashLogRing::MessageSize, log.format,
+                                                               log.arguments.data(), log.arguments.size());
+        ring.record(static_cast<int>(log.level), log.timestamp, log.callSite, log.threadId, text, size);
+        return;
+    }
+    ring.record(static_cast<int>(log.level), log.timestamp, log.callSite, log.threadId,
+                reinterpret_cast<const char16_t*>(log.message.utf16()), static_cast<size_t>(log.message.size()));
+}
+
+// Turns a LOG_*_F() record into a plain one, once an output is about to use its message.
+void resolveMessage(Logger::Log& log)
+{
+    if (!log.format) return;
+    log.message = Internal::LogFormatter::format(log.format, log.arguments.data(), log.arguments.size());
+    log.format = nullptr;
+    log.arguments.clear();
+}
+
+using CategoryRules = std::vector<Internal::LogCategoryRegistry::Rule>;
+
+bool parseCategoryLevel(const QString& text, int& level)
+{
+    static const QHash<QString, int> levels = {
+        { "debug",    static_cast<int>(Logger::LogLevel::Debug) },
+        { "info",     static_cast<int>(Logger::LogLevel::Info) },
+        { "warn",     static_cast<int>(Logger::LogLevel::Warning) },
+        { "warning",  static_cast<int>(Logger::LogLevel::Warning) },
+        { "error",    static_cast<int>(Logger::LogLevel::Critical) },
+        { "critical", static_cast<int>(Logger::LogLevel::Critical) },
+        { "fatal",    static_cast<int>(Logger::LogLevel::Fatal) },
+        { "off",      LogCategory::Off }
+    };
+
+    auto it = levels.constFind(text.trimmed().toLower());
+    if (it == levels.constEnd()) return false;
+    level = it.value();
+    return true;
+}
+
+// Parses "pattern=level" rules separated by ';' or new lines. Malformed rules are reported and skipped.
+bool parseCategoryRules(const QString& text, CategoryRules& rules)
+{
+    bool valid = true;
+    const QStringList entries = text.split(QRegularExpression("[;\\n]"), Qt::SkipEmptyParts);
+    for (const QString& entry : entries) {
+        const QString rule = entry.trimmed();
+        if (rule.isEmpty() || rule.startsWith('#')) continue;
+
+        const int separator = rule.indexOf('=');
+        const QString pattern = rule.left(separator).trimmed();
+        int level = 0;
+        if (separator <= 0 || pattern.isEmpty() || !parseCategoryLevel(rule.mid(separator + 1), level)) {
+            std::cout << "Failed to parse log rule: " << rule.toStdString() << std::endl;
+            valid = false;
+            continue;
+        }
+        rules.push_back({ pattern.toStdString(), level });
+    }
+    return valid;
+}
+
+using RateRules = std::vector<Internal::LogCategoryRegistry::RateRule>;
+
+// Parses "pattern=perSecond[:burst]" rules separated by ';' or new lines, "/s" after the rate is allowed.
+bool parseRateRules(const QString& text, RateRules& rules)
+{
+    static const QRegularExpression rulePattern("^(.+?)\\s*=\\s*(\\d+)\\s*(?:/s)?\\s*(?::\\s*(\\d+))?$");
+
+    bool valid = true;
+    const QStringList entries = text.split(QRegularExpression("[;\\n]"), Qt::SkipEmptyParts);
+    for (const QString& entry : entries) {
+        const QString rule = entry.trimmed();
+        if (rule.isEmpty() || rule.startsWith('#')) continue;
+
+        const QRegularExpressionMatch match = rulePattern.match(rule);
+        if (!match.hasMatch()) {
+            std::cout << "Failed to parse log rate limit: " << rule.toStdString() << std::endl;
+            valid = false;
+            continue;
+        }
+        rules.push_back({ match.captured(1).trimmed().toStdString(),
+                          match.captured(2).toInt(),
+                          match.captured(3).toInt() });
+    }
+    return valid;
+}
+
+bool readCategoryRulesFile(const QString& filePath, CategoryRules& rules)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        std::cout << "Failed to open log rules file: " << filePath.toStdString() << std::endl;
+        return false;
+    }
+    return parseCategoryRules(QString::fromUtf8(file.readAll()), rules);
+}
+
+
+}
+
 Logger* Logger::s_instance = nullptr;
 
-Logger::Logger(QObject* parent)
-    : QObject(parent)
-    , m_flushTimer(new QTimer(this))
-    , m_initialized(false)
+Logger::Logger()
+    : m_initialized(false)
+    , m_outputConfig(std::make_shared<const LogConfig>())
+    , m_flusherRunning(false)
+    , m_binaryLogFileBytes(0)
+    , m_metrics(std::make_unique<Internal::LogMetrics>())
+    , m_queueOpen(false)
+    , m_queueProducers(0)
+    , m_writerRunning(false)
+    , m_writerSleeping(false)
+    , m_droppedLogCount(0)
+    , m_sequence(0)
 {
+    m_archivePool.setMaxThreadCount(1);
 }
 
 Logger::~Logger()
@@ -44,28 +253,77 @@ void Logger::initialize(const LogConfig& config)
         }
 
         ensureLogDirectory();
+        Internal::LogClock::synchronize();
+
+        // Category levels: global level first, then config rules, rules file and environment
+        CategoryRules rules;
+        parseCategoryRules(m_config.categoryRules, rules);
+        if (!m_config.categoryRulesFile.isEmpty()) {
+            readCategoryRulesFile(m_config.categoryRulesFile, rules);
+        }
+        parseCategoryRules(qEnvironmentVariable("JAPP_LOG_RULES"), rules);
+        Internal::LogCategoryRegistry::instance().setDefaultLevel(static_cast<int>(m_config.minLevel));
+        Internal::LogCategoryRegistry::instance().setRules(std::move(rules));
+
+        RateRules rateRules;
+        parseRateRules(m_config.rateLimits, rateRules);
+        parseRateRules(qEnvironmentVariable("JAPP_LOG_RATE_LIMITS"), rateRules);
+        Internal::LogCategoryRegistry::instance().setRateRules(std::move(rateRules));
 
         // Setup file logging if enabled
         if (hasFlag(m_config.target, OutputTarget::File)) {
-            m_logFile = std::make_unique<QFile>(createLogFilePath());
-            if (m_logFile->open(QIODevice::WriteOnly | QIODevice::Append)) {
-                m_logStream = std::make_unique<QTextStream>(m_logFile.get());
-                m_logStream->setEncoding(QStringConverter::Utf8);
-            } else {
-                std::cout << "Failed to open log file: " << m_logFile->fileName().toStdString() << std::endl;
-            }
+            openLogFile();
+        }
+
+        // Setup memory-mapped logging if enabled
+        if (hasFlag(m_config.target, OutputTarget::MappedFile)) {
+            openMappedLogFile(0);
+        }
+
+        // Setup binary logging if enabled
+        if (hasFlag(m_config.target, OutputTarget::BinaryFile)) {
+            openBinaryLogFile();
+        }
+
+        if ((m_config.compression == Compression::Gzip && !Internal::LogCompression::isGzipAvailable())
+            || (m_config.compression == Compression::Zstd && !Internal::LogCompression::isZstdAvailable())) {
+            std::cout << "Log compression not available in this build, rotated files are kept as is" << std::endl;
+            m_config.compression = Compression::None;
+        }
+
+        // Enforce maxFileCount on files left by previous runs
+        const QString directory = m_config.logDirectory;
+        const QString prefix = m_config.logFilePrefix;
+        const int maxFileCount = m_config.maxFileCount;
+        m_archivePool.start([=]() {
+            pruneLogFiles(directory, QString("%1_*.log*").arg(prefix), maxFileCount);
+            pruneLogFiles(directory, QString("%1_*.jsonl*").arg(prefix), maxFileCount);
+            pruneLogFiles(directory, QString("%1_*.jlog*").arg(prefix), maxFileCount);
+            pruneLogFiles(directory, QString("%1_*.crash").arg(prefix), maxFileCount);
+        });
+
+        // Setup asynchronous writer if enabled
+        if (m_config.asynchronous) {
+            startWriterThread();
+        }
+
+        if (hasFlag(m_config.target, OutputTarget::Console)) {
+            addConsoleSink();
         }
 
         // Setup Qt message handler
         setupMessageHandler();
+        setupCrashLog();
 
-        m_flushTimer->setInterval(m_config.flushIntervalMs);
-        connect(m_flushTimer, &QTimer::timeout, this, &Logger::flushLogs);
-        m_flushTimer->start();
+        publishConfig();
+
+        // Periodic flushing runs on its own thread, with or without an event loop
+        startFlusherThread();
 
     } // Release mutex.
 
     m_initialized = true;
+    updateOutputLevel();
 
     LOG_INFO() << QString("Logger initialized - Target: %1, Level: %2, Directory: %3")
                   .arg(static_cast<int>(m_config.target))
@@ -77,36 +335,205 @@ void Logger::shutdown()
 {
     if (!m_initialized) return;
 
-    QMutexLocker locker(&m_mutex);
-    
-    if (m_flushTimer->isActive()) {
-        m_flushTimer->stop();
+    // Drain pending records and staged buffers before closing the file
+    stopWriterThread();
+    stopFlusherThread();
+    if (!m_config.metricsFile.isEmpty()) {
+        writeMetricsFile();
     }
-    
-    if (m_logStream) {
-        m_logStream->flush();
-        m_logStream.reset();
+#if JAPP_TRACING
+    if (!m_config.traceFile.isEmpty()) {
+        Tracer::instance().exportChromeTrace(m_config.traceFile);
     }
+#endif
+    removeAllSinks();
+
+    QMutexLocker locker(&m_mutex);
     
-    if (m_logFile) {
-        m_logFile->close();
-        m_logFile.reset();
+    m_logFile.reset();
+
+    if (m_binaryLogFile) {
+        m_binaryLogFile->close();
+        m_binaryLogFile.reset();
     }
+
+    {
+        // Truncates the segment to what was actually written
+        QWriteLocker mappedLocker(&m_mappedLogLock);
+        m_mappedLogFile.reset();
+    }
+
+    // Let pending compressions finish
+    m_archivePool.waitForDone();
     
     // Restore default message handler
     qInstallMessageHandler(nullptr);
+
+    Internal::CrashLogRing::instance().restoreSignalHandlers();
+    Internal::CrashLogRing::instance().setLevel(LogCategory::Off);
+    Internal::LogCategoryRegistry::instance().setCaptureLevel(LogCategory::Off);
+
+    // Allows initializing again, e.g. with another configuration
+    m_initialized = false;
+    updateOutputLevel();
 }
 
 void Logger::setLogLevel(LogLevel level)
 {
-    QMutexLocker locker(&m_mutex);
-    m_config.minLevel = level;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_config.minLevel = level;
+        publishConfig();
+    }
+    Internal::LogCategoryRegistry::instance().setDefaultLevel(static_cast<int>(level));
+}
+
+void Logger::setCategoryLevel(const QString& pattern, LogLevel level)
+{
+    Internal::LogCategoryRegistry::instance().addRule({ pattern.toStdString(), static_cast<int>(level) });
+}
+
+bool Logger::setCategoryRules(const QString& rules)
+{
+    CategoryRules parsed;
+    const bool valid = parseCategoryRules(rules, parsed);
+    Internal::LogCategoryRegistry::instance().setRules(std::move(parsed));
+    return valid;
+}
+
+bool Logger::loadCategoryRules(const QString& filePath)
+{
+    CategoryRules parsed;
+    if (!readCategoryRulesFile(filePath, parsed)) {
+        return false;
+    }
+    Internal::LogCategoryRegistry::instance().setRules(std::move(parsed));
+    return true;
+}
+
+void Logger::setRateLimit(const QString& pattern, int perSecond, int burst)
+{
+    Internal::LogCategoryRegistry::instance().addRateRule({ pattern.toStdString(), perSecond, burst });
+}
+
+bool Logger::setRateLimits(const QString& rules)
+{
+    RateRules parsed;
+    const bool valid = parseRateRules(rules, parsed);
+    Internal::LogCategoryRegistry::instance().setRateRules(std::move(parsed));
+    return valid;
 }
 
 void Logger::setOutputTarget(OutputTarget target)
 {
     QMutexLocker locker(&m_mutex);
     m_config.target = target;
+    publishConfig();
+
+    if (!m_initialized) return;
+
+    const bool console = hasFlag(target, OutputTarget::Console);
+    if (console && !m_consoleSink) {
+        addConsoleSink();
+    } else if (!console && m_consoleSink) {
+        removeSink(m_consoleSink);
+        m_consoleSink.reset();
+    }
+    updateOutputLevel();
+}
+
+void Logger::addConsoleSink()
+{
+    // Requires m_mutex. Console output has its own queue and thread, so slow terminals don't
+    // hold up the files until that queue is full. Then producers wait: console lines are never dropped.
+    LogSinkOptions options;
+    options.minLevel = m_config.consoleMinLevel;
+    options.overflowPolicy = OverflowPolicy::Block;
+    m_consoleSink = std::make_shared<ConsoleLogSink>();
+    addSink(m_consoleSink, options);
+}
+
+void Logger::addSink(std::shared_ptr<ILogSink> sink)
+{
+    addSink(std::move(sink), LogSinkOptions());
+}
+
+void Logger::addSink(std::shared_ptr<ILogSink> sink, const LogSinkOptions& options)
+{
+    if (!sink) return;
+
+    auto channel = std::make_unique<Internal::LogSinkChannel>(std::move(sink), options, m_droppedLogCount);
+    {
+        QWriteLocker locker(&m_sinksLock);
+        m_sinks.push_back(std::move(channel));
+    }
+    updateOutputLevel();
+}
+
+void Logger::removeSink(const std::shared_ptr<ILogSink>& sink)
+{
+    std::unique_ptr<Internal::LogSinkChannel> removed;
+    {
+        QWriteLocker locker(&m_sinksLock);
+        auto it = std::find_if(m_sinks.begin(), m_sinks.end(), [&](const auto& channel) {
+            return channel->sink() == sink;
+        });
+        if (it == m_sinks.end()) return;
+        removed = std::move(*it);
+        m_sinks.erase(it);
+    }
+
+    updateOutputLevel();
+
+    // Drains its queue outside the lock
+    removed->stop();
+}
+
+void Logger::updateOutputLevel()
+{
+    const std::shared_ptr<const LogConfig> config = outputConfig();
+
+    // Before initialize() records go to Qt's default output
+    int level = m_initialized ? LogCategory::Off : static_cast<int>(LogLevel::Debug);
+    if (m_initialized && (hasFlag(config->target, OutputTarget::File)
+                          || hasFlag(config->target, OutputTarget::MappedFile)
+                          || hasFlag(config->target, OutputTarget::BinaryFile))) {
+        level = std::min(level, static_cast<int>(config->fileMinLevel));
+    }
+    {
+        QReadLocker locker(&m_sinksLock);
+        for (const auto& channel : m_sinks) {
+            level = std::min(level, static_cast<int>(channel->minLevel()));
+        }
+    }
+    Internal::LogCategoryRegistry::instance().setOutputFloor(level);
+}
+
+void Logger::publishConfig()
+{
+    // Requires m_mutex. Logging threads keep the copy they loaded until they are done with a record.
+    std::atomic_store(&m_outputConfig, std::make_shared<const LogConfig>(m_config));
+}
+
+std::shared_ptr<const Logger::LogConfig> Logger::outputConfig() const
+{
+    return std::atomic_load(&m_outputConfig);
+}
+
+void Logger::removeAllSinks()
+{
+    std::vector<std::unique_ptr<Internal::LogSinkChannel>> removed;
+    {
+        QWriteLocker locker(&m_sinksLock);
+        removed.swap(m_sinks);
+    }
+    for (auto& channel : removed) {
+        channel->stop();
+    }
+
+    // Guarded like in setOutputTarget()
+    QMutexLocker locker(&m_mutex);
+    m_consoleSink.reset();
 }
 
 void Logger::setLogDirectory(const QString& directory)
@@ -114,49 +541,596 @@ void Logger::setLogDirectory(const QString& directory)
     QMutexLocker locker(&m_mutex);
     m_config.logDirectory = directory;
     ensureLogDirectory();
+    publishConfig();
+}
+
+quint64 Logger::droppedLogCount() const
+{
+    return m_droppedLogCount.load(std::memory_order_relaxed);
+}
+
+Logger::Stats Logger::stats() const
+{
+    Stats stats;
+    for (int level = 0; level < 5; ++level) {
+        stats.recordsPerLevel[level] = m_metrics->recordsPerLevel[level].load(std::memory_order_relaxed);
+    }
+
+    for (const auto& category : Internal::LogCategoryRegistry::instance().recordCounts()) {
+        if (category.second > 0) {
+            stats.recordsPerCategory.insert(QString::fromStdString(category.first), category.second);
+        }
+    }
+
+    const auto addOutput = [&](const QString& name, const Internal::LogOutputCounters& counters) {
+        stats.outputs.append({ name, counters.records.load(std::memory_order_relaxed),
+                               counters.bytes.load(std::memory_order_relaxed) });
+    };
+    addOutput("file", m_metrics->file);
+    addOutput("mapped_file", m_metrics->mappedFile);
+    addOutput("binary_file", m_metrics->binaryFile);
+    {
+        QReadLocker locker(&m_sinksLock);
+        for (const auto& channel : m_sinks) {
+            addOutput(QString::fromUtf8(channel->sink()->name()), channel->counters());
+        }
+    }
+
+    stats.mutexHold = toHistogram(m_metrics->mutexHold);
+    stats.flushLatency = toHistogram(m_metrics->flushLatency);
+    stats.rotations = m_metrics->rotations.load(std::memory_order_relaxed);
+    stats.dropped = m_droppedLogCount.load(std::memory_order_relaxed);
+    stats.suppressed = m_metrics->suppressed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void Logger::writeMetricsFile()
+{
+    static const char* const levels[] = { "debug", "info", "warning", "critical", "fatal" };
+    const Stats current = stats();
+
+    QString out;
+    appendMetric(out, "japp_log_records_total", "counter", "Records written, by level.");
+    for (int level = 0; level < 5; ++level) {
+        out += QString("japp_log_records_total{level=\"%1\"} %2\n").arg(levels[level]).arg(current.recordsPerLevel[level]);
+    }
+
+    appendMetric(out, "japp_log_category_records_total", "counter", "Records written, by category.");
+    for (auto it = current.recordsPerCategory.constBegin(); it != current.recordsPerCategory.constEnd(); ++it) {
+        out += QString("japp_log_category_records_total{category=\"%1\"} %2\n").arg(escapeLabel(it.key())).arg(it.value());
+    }
+
+    appendMetric(out, "japp_log_output_records_total", "counter", "Records written, by output.");
+    for (const OutputStats& output : current.outputs) {
+        out += QString("japp_log_output_records_total{output=\"%1\"} %2\n").arg(escapeLabel(output.name)).arg(output.records);
+    }
+    appendMetric(out, "japp_log_output_bytes_total", "counter", "Bytes written, by output.");
+    for (const OutputStats& output : current.outputs) {
+        out += QString("japp_log_output_bytes_total{output=\"%1\"} %2\n").arg(escapeLabel(output.name)).arg(output.bytes);
+    }
+
+    appendHistogram(out, "japp_log_mutex_hold_seconds", "Time the file output mutex was held.", current.mutexHold);
+    appendHistogram(out, "japp_log_flush_duration_seconds", "Duration of periodic flushes.", current.flushLatency);
+
+    appendMetric(out, "japp_log_rotations_total", "counter", "Log file rotations.");
+    out += QString("japp_log_rotations_total %1\n").arg(current.rotations);
+    appendMetric(out, "japp_log_dropped_records_total", "counter", "Records dropped by full queues.");
+    out += QString("japp_log_dropped_records_total %1\n").arg(current.dropped);
+    appendMetric(out, "japp_log_suppressed_records_total", "counter", "Records suppressed by rate limits.");
+    out += QString("japp_log_suppressed_records_total %1\n").arg(current.suppressed);
+
+    // Written aside and renamed, so the collector never reads a partial file
+    QSaveFile file(m_config.metricsFile);
+    if (!file.open(QIODevice::WriteOnly) || file.write(out.toUtf8()) < 0 || !file.commit()) {
+        std::cout << "Failed to write metrics file: " << m_config.metricsFile.toStdString() << std::endl;
+    }
+}
+
+void Logger::log(const LogCategory& category, LogCallSite& site, LogLevel level, QString&& message)
+{
+    Log log { 0, 0, level, std::move(message), 0 };
+    submitLog(category, site, std::move(log));
+}
+
+void Logger::log(const LogCategory& category, LogCallSite& site, LogLevel level, const char* format, LogArguments&& arguments)
+{
+    Log log { 0, 0, level, QString(), 0 };
+    log.format = format;
+    log.arguments = std::move(arguments);
+    submitLog(category, site, std::move(log));
+}
+
+void Logger::submitLog(const LogCategory& category, LogCallSite& site, Log&& log)
+{
+    log.callSite = Internal::LogCallSiteRegistry::instance().id(site);
+    log.timestamp = Internal::LogClock::now();
+    log.threadId = reinterpret_cast<quintptr>(QThread::currentThreadId());
+
+    // Collapse what the rate limiter held back into this record
+    if (site.suppressed.load(std::memory_order_relaxed) > 0) {
+        const quint32 suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+        site.suppressedLevel.store(0, std::memory_order_relaxed);
+        if (suppressed > 0) {
+            m_metrics->suppressed.fetch_add(suppressed, std::memory_order_relaxed);
+            resolveMessage(log);
+            log.message += QString(" (%1 similar messages suppressed)").arg(suppressed);
+        }
+    }
+
+    captureCrashLog(log);
+
+    // Messages below the output level were only built for the crash log
+    if (!category.isOutputEnabled(static_cast<int>(log.level))) {
+        return;
+    }
+    category.records.fetch_add(1, std::memory_order_relaxed);
+
+    // Keep Qt's default output until the logger is initialized
+    if (!m_initialized) {
+        resolveMessage(log);
+        QMessageLogContext context(site.file, site.line, site.function, site.category);
+        qt_message_output(logLevelToQtMsgType(log.level), context, log.message);
+        return;
+    }
+
+    handleLog(std::move(log));
 }
 
-void Logger::handleLog(const Log& log)
+void Logger::handleLog(Log&& log)
 {
     if (!m_initialized) return;
 
-    // Check if we should log this level
-    if (log.level < m_config.minLevel) {
+    log.sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+    m_metrics->recordsPerLevel[qBound(0, static_cast<int>(log.level), 4)].fetch_add(1, std::memory_order_relaxed);
+
+    // Counted so that stopWriterThread() doesn't free the queue under this producer
+    m_queueProducers.fetch_add(1);
+    if (m_queueOpen.load()) {
+        if (log.level < LogLevel::Fatal) {
+            enqueueLog(std::move(log));
+        } else {
+            writeFatalLog(std::move(log));
+        }
+        m_queueProducers.fetch_sub(1);
         return;
     }
+    m_queueProducers.fetch_sub(1);
+
+    writeLog(log);
+}
+
+void Logger::writeLog(Log& log)
+{
+    // The setters change m_config under m_mutex, which this path doesn't take
+    const std::shared_ptr<const LogConfig> configSnapshot = outputConfig();
+    const LogConfig& config = *configSnapshot;
+
+    const bool fileLevel = log.level >= config.fileMinLevel;
+    const bool fileOutput = fileLevel && (hasFlag(config.target, OutputTarget::File)
+                                          || hasFlag(config.target, OutputTarget::MappedFile));
+
+    const bool jsonFileOutput = fileOutput && config.fileFormat == FileFormat::JsonLines;
+
+    QReadLocker sinksLocker(&m_sinksLock);
+    const bool sinkOutput = std::any_of(m_sinks.begin(), m_sinks.end(), [&](const auto& channel) {
+        return channel->accepts(log.level);
+    });
+
+    // Deferred LOG_*_F() messages are formatted here, once, for all outputs that want them
+    if (fileOutput || sinkOutput || (fileLevel && hasFlag(config.target, OutputTarget::BinaryFile))) {
+        resolveMessage(log);
+    }
+
+    // Formatting only reads the configuration, so it stays outside the locks.
+    // The same text goes to the text files and every sink.
+    QString formattedMessage;
+    QByteArray line;
+    if ((fileOutput && !jsonFileOutput) || sinkOutput) {
+        formattedMessage = formatLog(log, config);
+    }
+
+    if (sinkOutput) {
+        writeSinks(log, formattedMessage);
+    }
+    sinksLocker.unlock();
+    if (jsonFileOutput) {
+        line.reserve(256 + log.message.size() * 3);
+        formatJsonLog(log, line);
+        line.append('\n');
+    } else if (fileOutput) {
+        line = formattedMessage.toUtf8();
+        line.append('\n');
+    }
+
+    // Memory-mapped output only needs a shared lock
+    if (fileLevel && hasFlag(config.target, OutputTarget::MappedFile)) {
+        writeMappedLog(line);
+    }
+
+    // Staged file output only locks the thread's own buffer until it needs flushing
+    const bool bufferedFileOutput = fileLevel && hasFlag(config.target, OutputTarget::File)
+                                    && config.threadBufferSize > 0;
+    if (bufferedFileOutput) {
+        bufferLogLine(line, log.level >= LogLevel::Warning, config);
+    }
+    if (fileLevel && hasFlag(config.target, OutputTarget::File)) {
+        m_metrics->file.records.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const bool binaryOutput = fileLevel && hasFlag(config.target, OutputTarget::BinaryFile);
+    const bool unbufferedFileOutput = fileLevel && hasFlag(config.target, OutputTarget::File) && !bufferedFileOutput;
+    if (!binaryOutput && !unbufferedFileOutput) return;
+
+    TimedMutexLocker locker(&m_mutex, m_metrics->mutexHold);
+
+    // Binary output skips text formatting entirely
+    if (binaryOutput && m_binaryLogFile) {
+        writeBinaryLog(log);
+    }
     
-    QMutexLocker locker(&m_mutex);
-    
-    QString formattedMessage = formatLog(log);
-    
-    // Console output
-    if (hasFlag(m_config.target, OutputTarget::Console)) {
-        if (log.level >= LogLevel::Critical) {
-            std::cerr << formattedMessage.toStdString() << std::endl;
+    // Unbuffered file output
+    if (unbufferedFileOutput) {
+        const QByteArray* chunk = &line;
+        writeLogFile(&chunk, 1);
+    }
+}
+
+void Logger::writeSinks(const Log& log, const QString& text)
+{
+    // Requires m_sinksLock. One shared record for all sinks, built only when one wants it.
+    auto record = std::make_shared<const LogRecord>(LogRecord { log, text });
+
+    for (const auto& channel : m_sinks) {
+        if (!channel->accepts(log.level)) continue;
+
+        // Fatal records must be out before Qt aborts
+        if (log.level >= LogLevel::Fatal) {
+            channel->writeNow(*record);
         } else {
-            std::cout << formattedMessage.toStdString() << std::endl;
+            channel->post(record);
         }
     }
-    
-    // File output
-    if (hasFlag(m_config.target, OutputTarget::File) && m_logStream) {
-        // Check file size and rotate if necessary
-        if (m_logFile->size() > m_config.maxFileSize) {
-            rotateLogFile();
+}
+
+void Logger::flushSinks()
+{
+    QReadLocker locker(&m_sinksLock);
+    for (const auto& channel : m_sinks) {
+        channel->flush();
+    }
+}
+
+Internal::ThreadLogBuffer& Logger::threadLogBuffer(const LogConfig& config)
+{
+    // Shared with m_threadBuffers so records of exited threads still get flushed
+    thread_local std::shared_ptr<Internal::ThreadLogBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<Internal::ThreadLogBuffer>();
+        buffer->data.reserve(config.threadBufferSize);
+
+        std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+        m_threadBuffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void Logger::bufferLogLine(const QByteArray& line, bool flushNow, const LogConfig& config)
+{
+    Internal::ThreadLogBuffer& buffer = threadLogBuffer(config);
+    std::lock_guard<std::mutex> bufferLock(buffer.mutex);
+
+    buffer.data.append(line);
+    if (!flushNow && buffer.data.size() < config.threadBufferSize) {
+        return;
+    }
+
+    const QByteArray* chunk = &buffer.data;
+    {
+        TimedMutexLocker locker(&m_mutex, m_metrics->mutexHold);
+        writeLogFile(&chunk, 1);
+    }
+    buffer.data.clear();
+}
+
+void Logger::writeLogFile(const QByteArray* const* chunks, size_t count)
+{
+    // Requires m_mutex
+    if (!m_logFile) return;
+
+    std::vector<Internal::LogFile::Chunk> fileChunks;
+    fileChunks.reserve(count);
+    qint64 size = 0;
+    for (size_t i = 0; i < count; ++i) {
+        fileChunks.push_back({ chunks[i]->constData(), static_cast<size_t>(chunks[i]->size()) });
+        size += chunks[i]->size();
+    }
+    if (size == 0) return;
+
+    // Check file size and rotate if necessary
+    if (m_logFile->size() > 0 && m_logFile->size() + size > m_config.maxFileSize) {
+        rotateLogFile();
+        if (!m_logFile) return;
+    }
+
+    if (!m_logFile->append(fileChunks.data(), fileChunks.size())) {
+        std::cout << "Failed to write log file: " << m_logFile->path() << std::endl;
+    }
+    m_metrics->file.bytes.fetch_add(static_cast<quint64>(size), std::memory_order_relaxed);
+}
+
+void Logger::writeMappedLog(const QByteArray& line)
+{
+    for (;;) {
+        {
+            QReadLocker locker(&m_mappedLogLock);
+            if (!m_mappedLogFile) return;
+            if (m_mappedLogFile->append(line.constData(), line.size())) {
+                m_metrics->mappedFile.add(static_cast<quint64>(line.size()));
+                return;
+            }
+        }
+        rotateMappedLogFile(line.size());
+    }
+}
+
+void Logger::enqueueLog(Log&& log)
+{
+    switch (m_config.overflowPolicy) {
+        case OverflowPolicy::Block:
+            while (!m_queue->tryPush(std::move(log))) {
+                m_writerCondition.notify_one();
+                std::this_thread::yield();
+            }
+            break;
+        case OverflowPolicy::DropNewest:
+            if (!m_queue->tryPush(std::move(log))) {
+                m_droppedLogCount.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            break;
+        case OverflowPolicy::DropOldest: {
+            Log evicted;
+            while (!m_queue->tryPush(std::move(log))) {
+                if (m_queue->tryPop(evicted)) {
+                    m_droppedLogCount.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            break;
+        }
+    }
+
+    // Only pay for the wake-up when the writer is actually parked
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_writerSleeping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        m_writerCondition.notify_one();
+    }
+}
+
+void Logger::writeFatalLog(Log&& log)
+{
+    // Qt aborts right after the handler returns, so the records queued before this one must be out by then
+    if (std::this_thread::get_id() == m_writerThread.get_id()) {
+        Log queued;
+        while (m_queue->tryPop(queued)) {
+            writeLog(queued);
+        }
+        writeLog(log);
+        return;
+    }
+
+    // Otherwise the writer thread writes it after them, whatever the overflow policy.
+    // A writer stuck on its output gets a few seconds. A record that couldn't be queued by then is
+    // written here, a queued one is left to the writer (the crash log keeps it anyway).
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    const quint64 sequence = log.sequence;
+    while (!m_queue->tryPush(std::move(log))) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            writeLog(log);
+            return;
         }
-        
-        *m_logStream << formattedMessage << Qt::endl;
+        m_writerCondition.notify_one();
+        std::this_thread::yield();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        m_writerCondition.notify_one();
+    }
+    std::unique_lock<std::mutex> lock(m_fatalLogsMutex);
+    const bool written = m_fatalLogsCondition.wait_until(lock, deadline, [&] {
+        return std::find(m_fatalLogsWritten.begin(), m_fatalLogsWritten.end(), sequence) != m_fatalLogsWritten.end();
+    });
+    if (written) {
+        m_fatalLogsWritten.erase(std::find(m_fatalLogsWritten.begin(), m_fatalLogsWritten.end(), sequence));
+    }
+}
+
+void Logger::startWriterThread()
+{
+    m_queue = std::make_unique<Internal::LogQueue<Log>>(qMax(m_config.queueCapacity, 2));
+    m_writerRunning.store(true);
+    m_writerThread = std::thread(&Logger::writerLoop, this);
+    m_queueOpen.store(true);
+}
+
+void Logger::stopWriterThread()
+{
+    if (!m_writerThread.joinable()) return;
+
+    // Later records are written synchronously, the ones being queued are waited for
+    m_queueOpen.store(false);
+    while (m_queueProducers.load() > 0) {
+        std::this_thread::yield();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        m_writerRunning.store(false);
+    }
+    m_writerCondition.notify_one();
+    m_writerThread.join();
+    m_queue.reset();
+}
+
+void Logger::writerLoop()
+{
+    Log log;
+
+    for (;;) {
+        bool wrote = false;
+        while (m_queue->tryPop(log)) {
+            writeLog(log);
+            if (log.level >= LogLevel::Fatal) {
+                {
+                    std::lock_guard<std::mutex> lock(m_fatalLogsMutex);
+                    m_fatalLogsWritten.push_back(log.sequence);
+                }
+                m_fatalLogsCondition.notify_all();
+            }
+            wrote = true;
+        }
+
+        if (wrote) continue;
+        if (!m_writerRunning.load()) break;
+
+        std::unique_lock<std::mutex> lock(m_writerMutex);
+        m_writerSleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_queue->isEmpty() && m_writerRunning.load()) {
+            m_writerCondition.wait_for(lock, std::chrono::milliseconds(m_config.flushIntervalMs));
+        }
+        m_writerSleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+void Logger::startFlusherThread()
+{
+    m_flusherRunning.store(true);
+    m_flusherThread = std::thread(&Logger::flusherLoop, this);
+}
+
+void Logger::stopFlusherThread()
+{
+    if (!m_flusherThread.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_flusherMutex);
+        m_flusherRunning.store(false);
+    }
+    m_flusherCondition.notify_one();
+    m_flusherThread.join();
+
+    flushLogs();
+}
+
+void Logger::flusherLoop()
+{
+    qint64 nextMetricsWrite = Internal::LogClock::now();
+
+    std::unique_lock<std::mutex> lock(m_flusherMutex);
+    while (m_flusherRunning.load()) {
+        m_flusherCondition.wait_for(lock, std::chrono::milliseconds(m_config.flushIntervalMs));
+        lock.unlock();
+        flushLogs();
+        Internal::LogClock::synchronize();
+
+        if (!m_config.metricsFile.isEmpty() && Internal::LogClock::now() >= nextMetricsWrite) {
+            writeMetricsFile();
+            nextMetricsWrite = Internal::LogClock::now() + qint64(qMax(m_config.metricsIntervalMs, 1)) * 1000000;
+        }
+        lock.lock();
+    }
+}
+
+void Logger::reportSuppressedLogs()
+{
+    // Call sites that went quiet since their last suppression won't report it themselves
+    Internal::LogCallSiteRegistry& registry = Internal::LogCallSiteRegistry::instance();
+    const quint32 end = registry.endId();
+    for (quint32 id = 1; id < end; ++id) {
+        LogCallSite* site = const_cast<LogCallSite*>(registry.site(id));
+        if (!site || site->suppressed.load(std::memory_order_relaxed) == 0
+            || !Internal::LogRateLimiter::isIdle(*site)) {
+            continue;
+        }
+
+        const quint32 suppressed = site->suppressed.exchange(0, std::memory_order_relaxed);
+        const int level = site->suppressedLevel.exchange(0, std::memory_order_relaxed);
+        if (suppressed == 0) continue;
+        m_metrics->suppressed.fetch_add(suppressed, std::memory_order_relaxed);
+
+        // The category's level may have been raised since
+        const LogCategory& category = Internal::LogCategoryRegistry::instance().category(site->category);
+        if (!category.isOutputEnabled(level)) continue;
+
+        Log log {
+            Internal::LogClock::now(),
+            id,
+            static_cast<LogLevel>(qBound(0, level, static_cast<int>(LogLevel::Critical))),
+            QString("Previous message repeated %1 more times").arg(suppressed),
+            reinterpret_cast<quintptr>(QThread::currentThreadId())
+        };
+        handleLog(std::move(log));
     }
 }
 
 void Logger::flushLogs()
 {
-    if (!m_initialized) return;
+    TRACE_SCOPE("flushLogs");
+    const qint64 start = Internal::LogClock::now();
 
-    QMutexLocker locker(&m_mutex);
-    if (m_logStream) {
-        m_logStream->flush();
+    if (m_initialized) {
+        reportSuppressedLogs();
+    }
+
+    // Each buffer stays locked until its records are written. Its owner would otherwise be able
+    // to write a Warning straight to the file, ahead of the older records taken out here.
+    // Owners lock their buffer, then m_mutex: the same order as here.
+    std::vector<std::shared_ptr<Internal::ThreadLogBuffer>> pending;
+    std::vector<std::unique_lock<std::mutex>> bufferLocks;
+    {
+        std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+        for (auto it = m_threadBuffers.begin(); it != m_threadBuffers.end();) {
+            // Only the registry still holds buffers of exited threads
+            const bool exited = it->use_count() == 1;
+
+            std::unique_lock<std::mutex> bufferLock((*it)->mutex);
+            if (!(*it)->data.isEmpty()) {
+                pending.push_back(*it);
+                bufferLocks.push_back(std::move(bufferLock));
+            }
+
+            if (exited) {
+                it = m_threadBuffers.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    std::vector<const QByteArray*> chunks;
+    chunks.reserve(pending.size());
+    for (const auto& buffer : pending) {
+        chunks.push_back(&buffer->data);
+    }
+
+    TimedMutexLocker locker(&m_mutex, m_metrics->mutexHold);
+
+    // One vectored write for all threads
+    writeLogFile(chunks.data(), chunks.size());
+    for (const auto& buffer : pending) {
+        buffer->data.resize(0); // Keeps the capacity for the next records
     }
+    bufferLocks.clear();
+
+    if (m_binaryLogFile) {
+        m_binaryLogFile->flush();
+    }
+    locker.unlock();
+
+    flushSinks();
+    m_metrics->flushLatency.record(Internal::LogClock::now() - start);
 }
 
 void Logger::setupMessageHandler()
@@ -164,23 +1138,54 @@ void Logger::setupMessageHandler()
     qInstallMessageHandler(&Logger::messageHandler);
 }
 
+void Logger::setupCrashLog()
+{
+    Internal::CrashLogRing& ring = Internal::CrashLogRing::instance();
+    const int level = m_config.crashLog ? static_cast<int>(m_config.crashLogLevel) : LogCategory::Off;
+
+    if (m_config.crashLog) {
+        // The path is fixed now: nothing can be formatted once the process is crashing
+        ring.setDumpPath(QFile::encodeName(createLogFilePath("crash")).constData());
+        ring.installSignalHandlers();
+    }
+
+    ring.setLevel(level);
+    Internal::LogCategoryRegistry::instance().setCaptureLevel(level);
+}
+
 void Logger::messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message)
 {
     if (!s_instance) {
         return;
     }
 
+    // Qt's own messages follow the same category rules as LOG_*()
+    const LogLevel level = qtMsgTypeToLogLevel(type);
+    const LogCategory& category = Internal::LogCategoryRegistry::instance().category(
+        context.category ? context.category : "default");
+    if (level < LogLevel::Fatal && !category.isEnabled(static_cast<int>(level))) {
+        return;
+    }
+
     Log log {
-        QDateTime::currentDateTime(),
-        context.category ? QString(context.category) : QString("?"),
-        qtMsgTypeToLogLevel(type),
-        context.file ? QString(context.file) : QString("?"),
-        context.function ? QString(context.function) : QString("?"),
-        context.line,
-        message
+        Internal::LogClock::now(),
+        Internal::LogCallSiteRegistry::instance().intern(context.category, context.file, context.function, context.line),
+        level,
+        message,
+        reinterpret_cast<quintptr>(QThread::currentThreadId())
     };
-    
-    s_instance->handleLog(log);
+
+    captureCrashLog(log);
+
+    if (level >= LogLevel::Fatal || category.isOutputEnabled(static_cast<int>(level))) {
+        category.records.fetch_add(1, std::memory_order_relaxed);
+        s_instance->handleLog(std::move(log));
+    }
+
+    // Qt aborts as soon as the handler returns
+    if (type == QtFatalMsg) {
+        Internal::CrashLogRing::instance().dump();
+    }
 }
 
 Logger::LogLevel Logger::qtMsgTypeToLogLevel(QtMsgType type)
@@ -195,39 +1200,309 @@ Logger::LogLevel Logger::qtMsgTypeToLogLevel(QtMsgType type)
     }
 }
 
+QtMsgType Logger::logLevelToQtMsgType(LogLevel level)
+{
+    switch (level) {
+        case LogLevel::Debug:    return QtDebugMsg;
+        case LogLevel::Info:     return QtInfoMsg;
+        case LogLevel::Warning:  return QtWarningMsg;
+        case LogLevel::Critical: return QtCriticalMsg;
+        case LogLevel::Fatal:    return QtFatalMsg;
+        default:                 return QtDebugMsg;
+    }
+}
+
+void Logger::openLogFile()
+{
+    m_logFile = std::make_unique<Internal::LogFile>();
+    if (!m_logFile->open(QFile::encodeName(createLogFilePath(textLogExtension())).toStdString())) {
+        std::cout << "Failed to open log file: " << m_logFile->path() << std::endl;
+        m_logFile.reset();
+    }
+}
+
 void Logger::rotateLogFile()
 {
-    if (!m_logFile || !m_logStream) return;
-    
-    m_logStream->flush();
+    if (!m_logFile) return;
+
+    m_metrics->rotations.fetch_add(1, std::memory_order_relaxed);
+    const QString rotatedPath = QFile::decodeName(m_logFile->path().c_str());
     m_logFile->close();
-    m_logFile = std::make_unique<QFile>(createLogFilePath());
-    if (m_logFile->open(QIODevice::WriteOnly | QIODevice::Append)) {
-        m_logStream = std::make_unique<QTextStream>(m_logFile.get());
-        m_logStream->setEncoding(QStringConverter::Utf8);
+    openLogFile();
+    archiveLogFile(rotatedPath, textLogExtension());
+}
+
+void Logger::openMappedLogFile(qint64 minimumSize)
+{
+    // Requires m_mutex
+    const qint64 capacity = qMax(m_config.maxFileSize, minimumSize);
+    m_mappedLogFile = std::make_unique<Internal::MappedLogFile>();
+    if (!m_mappedLogFile->open(createLogFilePath(textLogExtension()), capacity)) {
+        std::cout << "Failed to map log file: " << m_mappedLogFile->fileName().toStdString() << std::endl;
+        m_mappedLogFile.reset();
+    }
+}
+
+void Logger::rotateMappedLogFile(qint64 minimumSize)
+{
+    // The new path and the archive settings come from m_config. Locked in the same order as shutdown().
+    QMutexLocker locker(&m_mutex);
+    QWriteLocker mappedLocker(&m_mappedLogLock);
+
+    // Another writer may have rotated while we waited for the lock
+    if (!m_mappedLogFile || m_mappedLogFile->capacity() - m_mappedLogFile->length() >= minimumSize) return;
+
+    m_metrics->rotations.fetch_add(1, std::memory_order_relaxed);
+    const QString rotatedPath = m_mappedLogFile->fileName();
+    m_mappedLogFile->close();
+    openMappedLogFile(minimumSize);
+    archiveLogFile(rotatedPath, textLogExtension());
+}
+
+void Logger::rotateBinaryLogFile()
+{
+    if (!m_binaryLogFile) return;
+
+    m_metrics->rotations.fetch_add(1, std::memory_order_relaxed);
+    const QString rotatedPath = m_binaryLogFile->fileName();
+    m_binaryLogFile->close();
+    openBinaryLogFile();
+    archiveLogFile(rotatedPath, "jlog");
+}
+
+void Logger::archiveLogFile(const QString& path, const QString& extension)
+{
+    // The job runs on the archive thread, so it gets copies instead of m_config
+    const Compression compression = m_config.compression;
+    const QString directory = m_config.logDirectory;
+    const QString nameFilter = QString("%1_*.%2*").arg(m_config.logFilePrefix, extension);
+    const int maxFileCount = m_config.maxFileCount;
+
+    m_archivePool.start([=]() {
+        compressLogFile(path, compression);
+        pruneLogFiles(directory, nameFilter, maxFileCount);
+    });
+}
+
+void Logger::compressLogFile(const QString& path, Compression compression)
+{
+    QString destination;
+    bool compressed = false;
+
+    switch (compression) {
+        case Compression::None:
+            return;
+        case Compression::Gzip:
+            destination = path + ".gz";
+            compressed = Internal::LogCompression::gzipFile(QFile::encodeName(path).toStdString(),
+                                                            QFile::encodeName(destination).toStdString());
+            break;
+        case Compression::Zstd:
+            destination = path + ".zst";
+            compressed = Internal::LogCompression::zstdFile(QFile::encodeName(path).toStdString(),
+                                                            QFile::encodeName(destination).toStdString());
+            break;
+    }
+
+    if (compressed) {
+        QFile::remove(path);
+    } else {
+        std::cout << "Failed to compress log file: " << path.toStdString() << std::endl;
+    }
+}
+
+void Logger::pruneLogFiles(const QString& directory, const QString& nameFilter, int maxFileCount)
+{
+    if (maxFileCount <= 0) return;
+
+    // File names sort chronologically, see createLogFilePath()
+    QDir dir(directory);
+    const QStringList files = dir.entryList({ nameFilter }, QDir::Files, QDir::Name);
+    for (qsizetype i = 0; i < files.size() - maxFileCount; ++i) {
+        dir.remove(files.at(i));
+    }
+}
+
+void Logger::openBinaryLogFile()
+{
+    namespace Format = Internal::BinaryLogFormat;
+
+    m_internedStrings.clear();
+    m_binaryLogFileBytes = 0;
+    m_binaryLogFile = std::make_unique<QFile>(createLogFilePath("jlog"));
+    if (!m_binaryLogFile->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        std::cout << "Failed to open binary log file: " << m_binaryLogFile->fileName().toStdString() << std::endl;
+        m_binaryLogFile.reset();
+        return;
+    }
+
+    QByteArray header;
+    header.append(Format::Magic, sizeof(Format::Magic));
+    Format::append<quint16>(header, Format::Version);
+    Format::append<quint16>(header, Format::FileHeaderSize);
+    Format::append<quint64>(header, Format::TicksPerSecond);
+    m_binaryLogFile->write(header);
+    m_binaryLogFileBytes = header.size();
+}
+
+void Logger::writeBinaryLog(const Log& log)
+{
+    namespace Format = Internal::BinaryLogFormat;
+
+    if (m_binaryLogFileBytes > m_config.maxFileSize) {
+        rotateBinaryLogFile();
+        if (!m_binaryLogFile) return;
+    }
+
+    m_binaryBuffer.clear();
+
+    const LogCallSite* site = Internal::LogCallSiteRegistry::instance().site(log.callSite);
+
+    // Interning may prepend String records to the buffer
+    const quint32 categoryId = internString(site ? site->category : "?");
+    const quint32 functionId = internString(site ? site->function : "?");
+    const quint32 fileId = internString(site ? site->file : "?");
+    const QByteArray payload = log.message.toUtf8();
+
+    Format::append<quint8>(m_binaryBuffer, static_cast<quint8>(Format::RecordType::Log));
+    Format::append<quint8>(m_binaryBuffer, static_cast<quint8>(log.level));
+    Format::append<qint64>(m_binaryBuffer, Internal::LogClock::toEpochNanoseconds(log.timestamp));
+    Format::append<quint32>(m_binaryBuffer, categoryId);
+    Format::append<quint32>(m_binaryBuffer, functionId);
+    Format::append<quint32>(m_binaryBuffer, fileId);
+    Format::append<qint32>(m_binaryBuffer, site ? site->line : 0);
+    Format::append<quint64>(m_binaryBuffer, log.threadId);
+    Format::append<quint32>(m_binaryBuffer, static_cast<quint32>(payload.size()));
+    m_binaryBuffer.append(payload);
+
+    m_binaryLogFile->write(m_binaryBuffer);
+    m_binaryLogFileBytes += m_binaryBuffer.size();
+    m_metrics->binaryFile.add(static_cast<quint64>(m_binaryBuffer.size()));
+}
+
+quint32 Logger::internString(const char* string)
+{
+    namespace Format = Internal::BinaryLogFormat;
+
+    // Call site strings have static storage, so their address identifies them
+
+    auto it = m_internedStrings.constFind(string);
+    if (it != m_internedStrings.constEnd()) {
+        return it.value();
     }
+
+    const quint32 id = static_cast<quint32>(m_internedStrings.size());
+    m_internedStrings.insert(string, id);
+
+    const QByteArray utf8(string);
+    Format::append<quint8>(m_binaryBuffer, static_cast<quint8>(Format::RecordType::String));
+    Format::append<quint32>(m_binaryBuffer, id);
+    Format::append<quint32>(m_binaryBuffer, static_cast<quint32>(utf8.size()));
+    m_binaryBuffer.append(utf8);
+    return id;
 }
 
-QString Logger::formatLog(const Log& log)
+QString Logger::formatTimestamp(qint64 timestamp, const LogConfig& config) const
 {
+    static constexpr qint64 NanosecondsPerMinute = Q_INT64_C(60000000000);
+
+    const qint64 nanoseconds = Internal::LogClock::toEpochNanoseconds(timestamp);
+    if (config.timestampFormat == TimestampFormat::EpochNanoseconds) {
+        return QString::number(nanoseconds);
+    }
+
+    // Date, hour and minute are rendered once per minute and thread, the rest by hand
+    struct Cache {
+        qint64 minute = std::numeric_limits<qint64>::min();
+        TimestampFormat format = TimestampFormat::Local;
+        QString prefix;
+    };
+    thread_local Cache cache;
+
+    qint64 minute = nanoseconds / NanosecondsPerMinute;
+    qint64 remainder = nanoseconds % NanosecondsPerMinute;
+    if (remainder < 0) {
+        --minute;
+        remainder += NanosecondsPerMinute;
+    }
+
+    if (cache.minute != minute || cache.format != config.timestampFormat) {
+        const qint64 msecs = minute * 60000;
+        cache.prefix = config.timestampFormat == TimestampFormat::Rfc3339
+            ? QDateTime::fromMSecsSinceEpoch(msecs).toUTC().toString("yyyy-MM-dd'T'hh:mm:")
+            : QDateTime::fromMSecsSinceEpoch(msecs).toString("yyyy-MM-dd hh:mm:");
+        cache.minute = minute;
+        cache.format = config.timestampFormat;
+    }
+
+    const bool rfc3339 = config.timestampFormat == TimestampFormat::Rfc3339;
+    const int fractionDigits = rfc3339 ? 6 : 3;
+    const qint64 fraction = (remainder % 1000000000) / (rfc3339 ? 1000 : 1000000);
+
+    QString result;
+    result.reserve(cache.prefix.size() + fractionDigits + 4);
+    result += cache.prefix;
+    result += QString::number(remainder / 1000000000).rightJustified(2, QLatin1Char('0'));
+    result += QLatin1Char('.');
+    result += QString::number(fraction).rightJustified(fractionDigits, QLatin1Char('0'));
+    if (rfc3339) {
+        result += QLatin1Char('Z');
+    }
+    return result;
+}
+
+void Logger::formatJsonLog(const Log& log, QByteArray& out) const
+{
+    namespace Json = Internal::JsonLogWriter;
+
+    static const char* const levels[] = { "debug", "info", "warning", "critical", "fatal" };
+    const int levelIndex = static_cast<int>(log.level);
+    const LogCallSite* site = Internal::LogCallSiteRegistry::instance().site(log.callSite);
+
+    // Every field is always present, whatever the text formatting toggles say
+    out.append('{');
+    Json::appendKey(out, "seq", true);
+    Json::appendNumber(out, static_cast<qint64>(log.sequence));
+    Json::appendKey(out, "ts");
+    Json::appendNumber(out, Internal::LogClock::toEpochNanoseconds(log.timestamp));
+    Json::appendKey(out, "level");
+    Json::appendString(out, levelIndex >= 0 && levelIndex <= 4 ? levels[levelIndex] : "unknown");
+    Json::appendKey(out, "category");
+    Json::appendString(out, site ? site->category : "?");
+    Json::appendKey(out, "function");
+    Json::appendString(out, site ? site->function : "");
+    Json::appendKey(out, "file");
+    Json::appendString(out, site ? site->file : "");
+    Json::appendKey(out, "line");
+    Json::appendNumber(out, site ? site->line : 0);
+    Json::appendKey(out, "thread");
+    Json::appendHexString(out, log.threadId);
+    Json::appendKey(out, "message");
+    Json::appendString(out, QStringView(log.message));
+    out.append('}');
+}
+
+QString Logger::formatLog(const Log& log, const LogConfig& config)
+{
+    const LogCallSite* site = Internal::LogCallSiteRegistry::instance().site(log.callSite);
     QStringList parts;
     
     // Timestamp
-    if (m_config.enableTimestamp) {
-        parts << log.timestamp.toString("yyyy-MM-dd hh:mm:ss.zzz");
+    if (config.enableTimestamp) {
+        parts << formatTimestamp(log.timestamp, config);
     }
     
     // Level
     parts << QString("%1").arg(levelToString(log.level));
 
     // Category
-    parts << QString("%1").arg(log.category);
+    parts << QString::fromUtf8(site ? site->category : "?");
     
     // Function and line
-    if (m_config.enableFunction && !log.function.isEmpty()) {
-        QString funcInfo = log.function;
-        if (m_config.enableLineNumber && log.line > 0) {
-            funcInfo += QString(":%1").arg(log.line);
+    if (config.enableFunction && site && site->function[0] != '\0') {
+        QString funcInfo = QString::fromUtf8(site->function);
+        if (config.enableLineNumber && site->line > 0) {
+            funcInfo += QString(":%1").arg(site->line);
         }
         parts << QString("%1").arg(funcInfo);
     }
@@ -236,8 +1511,8 @@ QString Logger::formatLog(const Log& log)
     parts << log.message;
 
     // Thread ID
-    if (m_config.enableThreadId) {
-        parts << QString("%1").arg(reinterpret_cast<quintptr>(QThread::currentThread()), 0, 16);
+    if (config.enableThreadId) {
+        parts << QString("%1").arg(log.threadId, 0, 16);
     }
     
     return parts.join(" | ");
@@ -255,12 +1530,25 @@ QString Logger::levelToString(LogLevel level)
     }
 }
 
-QString Logger::createLogFilePath()
+QString Logger::textLogExtension() const
 {
-    return QString("%1/%2_%3.log")
+    return m_config.fileFormat == FileFormat::JsonLines ? "jsonl" : "log";
+}
+
+QString Logger::createLogFilePath(const QString& extension)
+{
+    const QString base = QString("%1/%2_%3")
         .arg(m_config.logDirectory)
         .arg(m_config.logFilePrefix)
         .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd_hh'h'mm'm'ss's'"));
+
+    // Files created within the same second get a zero-padded sequence number,
+    // which keeps names sorting chronologically ('.' sorts before '_').
+    QString path = QString("%1.%2").arg(base, extension);
+    for (int sequence = 1; QFile::exists(path) || QFile::exists(path + ".gz") || QFile::exists(path + ".zst"); ++sequence) {
+        path = QString("%1_%2.%3").arg(base).arg(sequence, 3, 10, QLatin1Char('0')).arg(extension);
+    }
+    return path;
 }
 
 void Logger::ensureLogDirectory()
@@ -0,0 +1,65 @@
+#include "JApp/Internal/MappedLogFile.h"
+#include <cstring>
+
+using namespace JApp::Internal;
+
+MappedLogFile::~MappedLogFile()
+{
+    close();
+}
+
+bool MappedLogFile::open(const QString& path, qint64 capacity)
+{
+    close();
+
+    // Mapping for writing needs a readable descriptor
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        return false;
+    }
+
+    if (!m_file.resize(capacity) || !(m_data = m_file.map(0, capacity))) {
+        m_file.close();
+        m_file.remove();
+        return false;
+    }
+
+    m_capacity = capacity;
+    m_reserved.store(0, std::memory_order_relaxed);
+    m_firstOverflow.store(capacity, std::memory_order_relaxed);
+    return true;
+}
+
+void MappedLogFile::close()
+{
+    if (!m_data) return;
+
+    const qint64 written = length();
+    m_file.unmap(m_data);
+    m_data = nullptr;
+    m_file.resize(written);
+    m_file.close();
+    m_capacity = 0;
+}
+
+bool MappedLogFile::append(const char* data, qint64 size)
+{
+    const qint64 offset = m_reserved.fetch_add(size, std::memory_order_relaxed);
+
+    if (offset + size > m_capacity) {
+        // Reservations are ordered, so the first overflowing one marks the end of the data
+        qint64 firstOverflow = m_firstOverflow.load(std::memory_order_relaxed);
+        while (offset < firstOverflow
+               && !m_firstOverflow.compare_exchange_weak(firstOverflow, offset, std::memory_order_relaxed)) {
+        }
+        return false;
+    }
+
+    std::memcpy(m_data + offset, data, static_cast<size_t>(size));
+    return true;
+}
+
+qint64 MappedLogFile::length() const
+{
+    return qMin(m_reserved.load(std::memory_order_relaxed), m_firstOverflow.load(std::memory_order_relaxed));
+}
@@ -0,0 +1,43 @@
+#include "JApp/MemoryLogSink.h"
+
+using namespace JApp;
+
+MemoryLogSink::MemoryLogSink(int capacity)
+    : m_capacity(static_cast<size_t>(qMax(capacity, 1)))
+    , m_next(0)
+{
+    m_records.reserve(m_capacity);
+}
+
+void MemoryLogSink::write(const LogRecord& record)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_records.size() < m_capacity) {
+        m_records.push_back(record);
+    } else {
+        m_records[m_next] = record;
+    }
+    m_next = (m_next + 1) % m_capacity;
+}
+
+QList<LogRecord> MemoryLogSink::records() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    QList<LogRecord> result;
+    result.reserve(static_cast<qsizetype>(m_records.size()));
+
+    // Once full, the oldest record is the one about to be overwritten
+    const size_t start = m_records.size() < m_capacity ? 0 : m_next;
+    for (size_t i = 0; i < m_records.size(); ++i) {
+        result.append(m_records[(start + i) % m_records.size()]);
+    }
+    return result;
+}
+
+void MemoryLogSink::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_records.clear();
+    m_next = 0;
+}
@@ -0,0 +1,98 @@
+#include "JApp/SyslogLogSink.h"
+#include "JApp/Internal/LogCallSiteRegistry.h"
+#include <QCoreApplication>
+
+#ifdef Q_OS_UNIX
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+using namespace JApp;
+
+SyslogLogSink::SyslogLogSink(const QString& socketPath, const QString& identity, int facility)
+    : m_socketPath(socketPath.toUtf8())
+    , m_facility(qBound(0, facility, 23))
+    , m_socket(-1)
+{
+    const QString name = identity.isEmpty() ? QCoreApplication::applicationName() : identity;
+    m_tag = QString("%1[%2]: ").arg(name.isEmpty() ? QString("japp") : name).arg(QCoreApplication::applicationPid()).toUtf8();
+    connectSocket();
+}
+
+SyslogLogSink::~SyslogLogSink()
+{
+    closeSocket();
+}
+
+int SyslogLogSink::severity(Logger::LogLevel level)
+{
+    switch (level) {
+        case Logger::LogLevel::Debug:    return 7;
+        case Logger::LogLevel::Info:     return 6;
+        case Logger::LogLevel::Warning:  return 4;
+        case Logger::LogLevel::Critical: return 3;
+        case Logger::LogLevel::Fatal:    return 2;
+        default:                         return 5;
+    }
+}
+
+void SyslogLogSink::write(const LogRecord& record)
+{
+#ifdef Q_OS_UNIX
+    const LogCallSite* site = Internal::LogCallSiteRegistry::instance().site(record.log.callSite);
+
+    // The syslog daemon adds its own timestamp and host name
+    m_datagram.clear();
+    m_datagram.append('<');
+    m_datagram.append(QByteArray::number(m_facility * 8 + severity(record.log.level)));
+    m_datagram.append('>');
+    m_datagram.append(m_tag);
+    m_datagram.append(site ? site->category : "?");
+    m_datagram.append(": ");
+    m_datagram.append(record.log.message.toUtf8());
+
+    // Reconnect once if the daemon was restarted
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (m_socket < 0 && !connectSocket()) return;
+        if (::send(m_socket, m_datagram.constData(), static_cast<size_t>(m_datagram.size()), 0) >= 0) return;
+        if (errno != ECONNREFUSED && errno != ENOTCONN && errno != EBADF) return;
+        closeSocket();
+    }
+#else
+    Q_UNUSED(record);
+#endif
+}
+
+bool SyslogLogSink::connectSocket()
+{
+#ifdef Q_OS_UNIX
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    if (m_socketPath.size() >= static_cast<qsizetype>(sizeof(address.sun_path))) return false;
+    std::memcpy(address.sun_path, m_socketPath.constData(), static_cast<size_t>(m_socketPath.size()));
+
+    m_socket = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (m_socket < 0) return false;
+
+    if (::connect(m_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0) {
+        closeSocket();
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SyslogLogSink::closeSocket()
+{
+#ifdef Q_OS_UNIX
+    if (m_socket >= 0) {
+        ::close(m_socket);
+        m_socket = -1;
+    }
+#endif
+}
@@ -0,0 +1,169 @@
+#include "JApp/Tracer.h"
+#include "JApp/Internal/JsonLogWriter.h"
+#include "JApp/Internal/LogClock.h"
+#include "JApp/Internal/ThreadTraceBuffer.h"
+#include <QCoreApplication>
+#include <QSaveFile>
+#include <QThread>
+#include <algorithm>
+#include <iostream>
+
+using namespace JApp;
+namespace Json = JApp::Internal::JsonLogWriter;
+
+namespace {
+
+// Chrome trace timestamps are microseconds, fractions keep the nanosecond resolution.
+void appendMicroseconds(QByteArray& out, qint64 nanoseconds)
+{
+    Json::appendNumber(out, nanoseconds / 1000);
+    const int fraction = static_cast<int>(nanoseconds % 1000);
+    if (fraction > 0) {
+        const char digits[] = { '.', char('0' + fraction / 100), char('0' + fraction / 10 % 10), char('0' + fraction % 10) };
+        out.append(digits, sizeof(digits));
+    }
+}
+
+}
+
+Tracer& Tracer::instance()
+{
+    static Tracer instance;
+    return instance;
+}
+
+void Tracer::setEnabled(bool enabled)
+{
+    m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracer::begin(const char* category, const char* name)
+{
+    if (!isEnabled()) return;
+    record(category, name, 'B', Internal::LogClock::now(), 0);
+}
+
+void Tracer::end(const char* category, const char* name)
+{
+    if (!isEnabled()) return;
+    record(category, name, 'E', Internal::LogClock::now(), 0);
+}
+
+void Tracer::complete(const char* category, const char* name, qint64 start, qint64 end)
+{
+    if (!isEnabled()) return;
+    record(category, name, 'X', start, end - start);
+}
+
+void Tracer::record(const char* category, const char* name, char phase, qint64 timestamp, qint64 duration)
+{
+    Internal::ThreadTraceBuffer& buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    if (buffer.events.size() >= Internal::ThreadTraceBuffer::MaxEvents) {
+        m_droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer.events.push_back({ category, name, timestamp, duration, phase });
+}
+
+Internal::ThreadTraceBuffer& Tracer::threadBuffer()
+{
+    // The list keeps buffers of finished threads alive until they are exported or cleared
+    thread_local std::shared_ptr<Internal::ThreadTraceBuffer> buffer = [this]() {
+        auto created = std::make_shared<Internal::ThreadTraceBuffer>();
+        created->threadId = reinterpret_cast<quintptr>(QThread::currentThreadId());
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        m_buffers.push_back(created);
+        return created;
+    }();
+    return *buffer;
+}
+
+bool Tracer::exportChromeTrace(const QString& filePath)
+{
+    std::vector<std::shared_ptr<Internal::ThreadTraceBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        buffers = m_buffers;
+    }
+
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    QByteArray out;
+    out.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    std::vector<Internal::TraceEvent> events;
+    for (const auto& buffer : buffers) {
+        {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            events = buffer->events;
+        }
+        for (const Internal::TraceEvent& event : events) {
+            if (!first) {
+                out.append(',');
+            }
+            first = false;
+            out.append('{');
+            Json::appendKey(out, "name", true);
+            Json::appendString(out, event.name);
+            Json::appendKey(out, "cat");
+            Json::appendString(out, event.category);
+            Json::appendKey(out, "ph");
+            out.append('"').append(event.phase).append('"');
+            Json::appendKey(out, "ts");
+            appendMicroseconds(out, Internal::LogClock::toEpochNanoseconds(event.timestamp));
+            if (event.phase == 'X') {
+                Json::appendKey(out, "dur");
+                appendMicroseconds(out, event.duration);
+            }
+            Json::appendKey(out, "pid");
+            Json::appendNumber(out, pid);
+            Json::appendKey(out, "tid");
+            Json::appendNumber(out, static_cast<std::int64_t>(buffer->threadId));
+            out.append("}\n");
+        }
+    }
+    out.append("]}\n");
+
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(out) != out.size() || !file.commit()) {
+        std::cout << "Failed to write trace file: " << filePath.toStdString() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void Tracer::clear()
+{
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+    for (const auto& buffer : m_buffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->events.clear();
+    }
+    // Buffers only referenced here belong to threads that have exited
+    m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+                                   [](const std::shared_ptr<Internal::ThreadTraceBuffer>& buffer) {
+                                       return buffer.use_count() == 1;
+                                   }),
+                    m_buffers.end());
+    m_droppedEventCount.store(0, std::memory_order_relaxed);
+}
+
+quint64 Tracer::droppedEventCount() const
+{
+    return m_droppedEventCount.load(std::memory_order_relaxed);
+}
+
+TraceScope::TraceScope(const char* category, const char* name)
+    : m_category(category)
+    , m_name(name)
+    , m_start(Tracer::instance().isEnabled() ? Internal::LogClock::now() : 0)
+{
+}
+
+TraceScope::~TraceScope()
+{
+    if (m_start != 0) {
+        Tracer::instance().complete(m_category, m_name, m_start, Internal::LogClock::now());
+    }
+}
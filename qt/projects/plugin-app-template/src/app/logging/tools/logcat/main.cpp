@@ -0,0 +1,199 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QStringList>
+#include <QTextStream>
+#include <JApp/Logger.h>
+#include <JApp/Internal/BinaryLogFormat.h>
+#include <cstring>
+#include <limits>
+
+using namespace JApp;
+namespace Format = JApp::Internal::BinaryLogFormat;
+
+namespace {
+
+struct Filters {
+    Logger::LogLevel minLevel = Logger::LogLevel::Debug;
+    QStringList categories;
+    qint64 since = std::numeric_limits<qint64>::min();
+    qint64 until = std::numeric_limits<qint64>::max();
+};
+
+bool parseLevel(const QString& text, Logger::LogLevel& level)
+{
+    static const QHash<QString, Logger::LogLevel> levels = {
+        { "debug",    Logger::LogLevel::Debug },
+        { "info",     Logger::LogLevel::Info },
+        { "warn",     Logger::LogLevel::Warning },
+        { "warning",  Logger::LogLevel::Warning },
+        { "error",    Logger::LogLevel::Critical },
+        { "critical", Logger::LogLevel::Critical },
+        { "fatal",    Logger::LogLevel::Fatal }
+    };
+
+    auto it = levels.constFind(text.toLower());
+    if (it == levels.constEnd()) return false;
+    level = it.value();
+    return true;
+}
+
+bool parseTime(const QString& text, qint64& msecs)
+{
+    QDateTime dateTime = QDateTime::fromString(text, Qt::ISODateWithMs);
+    if (!dateTime.isValid()) {
+        dateTime = QDateTime::fromString(text, "yyyy-MM-dd hh:mm:ss.zzz");
+    }
+    if (!dateTime.isValid()) {
+        dateTime = QDateTime::fromString(text, "yyyy-MM-dd hh:mm:ss");
+    }
+    if (!dateTime.isValid()) return false;
+    msecs = dateTime.toMSecsSinceEpoch();
+    return true;
+}
+
+bool acceptsCategory(const Filters& filters, const QString& category)
+{
+    if (filters.categories.isEmpty()) return true;
+    for (const QString& accepted : filters.categories) {
+        if (category == accepted) return true;
+    }
+    return false;
+}
+
+// Decodes one file, printing records the same way Logger::formatLog does.
+bool decodeFile(const QString& path, const Filters& filters, QTextStream& out, QTextStream& err)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        err << "Failed to open " << path << Qt::endl;
+        return false;
+    }
+
+    const QByteArray content = file.readAll();
+    const char* data = content.constData();
+    const qsizetype size = content.size();
+
+    if (size < Format::FileHeaderSize || std::memcmp(data, Format::Magic, sizeof(Format::Magic)) != 0) {
+        err << path << ": not a binary log file" << Qt::endl;
+        return false;
+    }
+
+    const quint16 version = Format::read<quint16>(data + 4);
+    const quint16 headerSize = Format::read<quint16>(data + 6);
+    const quint64 ticksPerSecond = Format::read<quint64>(data + 8);
+    if (version > Format::Version || ticksPerSecond == 0) {
+        err << path << ": unsupported binary log version " << version << Qt::endl;
+        return false;
+    }
+
+    QHash<quint32, QString> strings;
+    qsizetype pos = headerSize;
+
+    while (pos < size) {
+        const auto type = static_cast<Format::RecordType>(static_cast<quint8>(data[pos]));
+
+        if (type == Format::RecordType::String) {
+            if (pos + Format::StringHeaderSize > size) break;
+            const quint32 id = Format::read<quint32>(data + pos + 1);
+            const quint32 length = Format::read<quint32>(data + pos + 5);
+            if (pos + Format::StringHeaderSize + length > size) break;
+            strings.insert(id, QString::fromUtf8(data + pos + Format::StringHeaderSize, length));
+            pos += Format::StringHeaderSize + length;
+        } else if (type == Format::RecordType::Log) {
+            if (pos + Format::LogHeaderSize > size) break;
+            const char* record = data + pos;
+            const auto level = static_cast<Logger::LogLevel>(static_cast<quint8>(record[1]));
+            const qint64 ticks = Format::read<qint64>(record + 2);
+            const quint32 categoryId = Format::read<quint32>(record + 10);
+            const quint32 functionId = Format::read<quint32>(record + 14);
+            const qint32 line = Format::read<qint32>(record + 22);
+            const quint64 threadId = Format::read<quint64>(record + 26);
+            const quint32 payloadSize = Format::read<quint32>(record + 34);
+            if (pos + Format::LogHeaderSize + payloadSize > size) break;
+            pos += Format::LogHeaderSize + payloadSize;
+
+            const qint64 msecs = ticksPerSecond >= 1000
+                ? ticks / static_cast<qint64>(ticksPerSecond / 1000)
+                : ticks * 1000 / static_cast<qint64>(ticksPerSecond);
+            const QString category = strings.value(categoryId, "?");
+            if (level < filters.minLevel || msecs < filters.since || msecs > filters.until
+                || !acceptsCategory(filters, category)) {
+                continue;
+            }
+
+            QString function = strings.value(functionId, "?");
+            if (line > 0) {
+                function += QString(":%1").arg(line);
+            }
+
+            QStringList parts;
+            parts << QDateTime::fromMSecsSinceEpoch(msecs).toString("yyyy-MM-dd hh:mm:ss.zzz");
+            parts << Logger::levelToString(level);
+            parts << category;
+            parts << function;
+            parts << QString::fromUtf8(record + Format::LogHeaderSize, payloadSize);
+            parts << QString("%1").arg(threadId, 0, 16);
+            out << parts.join(" | ") << '\n';
+        } else {
+            err << path << ": corrupted record at offset " << pos << Qt::endl;
+            return false;
+        }
+    }
+
+    if (pos < size) {
+        err << path << ": truncated record at offset " << pos << Qt::endl;
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("japp-logcat");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Decodes binary JApp log files into text.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("files", "Binary log files (.jlog) to decode.", "<files...>");
+
+    QCommandLineOption levelOption({ "l", "level" }, "Minimum level: debug, info, warn, error, fatal.", "level");
+    QCommandLineOption categoryOption({ "c", "category" }, "Only show this category (repeatable).", "category");
+    QCommandLineOption sinceOption({ "s", "since" }, "Only show records at or after this time (ISO 8601).", "time");
+    QCommandLineOption untilOption({ "u", "until" }, "Only show records at or before this time (ISO 8601).", "time");
+    parser.addOptions({ levelOption, categoryOption, sinceOption, untilOption });
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    Filters filters;
+    if (parser.isSet(levelOption) && !parseLevel(parser.value(levelOption), filters.minLevel)) {
+        err << "Invalid level: " << parser.value(levelOption) << Qt::endl;
+        return 1;
+    }
+    filters.categories = parser.values(categoryOption);
+    if (parser.isSet(sinceOption) && !parseTime(parser.value(sinceOption), filters.since)) {
+        err << "Invalid time: " << parser.value(sinceOption) << Qt::endl;
+        return 1;
+    }
+    if (parser.isSet(untilOption) && !parseTime(parser.value(untilOption), filters.until)) {
+        err << "Invalid time: " << parser.value(untilOption) << Qt::endl;
+        return 1;
+    }
+
+    const QStringList files = parser.positionalArguments();
+    if (files.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    bool success = true;
+    for (const QString& path : files) {
+        success = decodeFile(path, filters, out, err) && success;
+    }
+    return success ? 0 : 1;
+}
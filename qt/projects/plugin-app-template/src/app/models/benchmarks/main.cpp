@@ -0,0 +1,281 @@
+#include <QAbstractListModel>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QTextStream>
+#include "qqmlsortfilterproxymodel.h"
+#include "filters/filter.h"
+#include "filters/expressionfilter.h"
+#include "filters/rangefilter.h"
+#include "filters/predicatefilter.h"
+#include "sorters/sorter.h"
+#include "sorters/rolesorter.h"
+#include "sorters/expressionsorter.h"
+#include "sorters/predicatesorter.h"
+#include "proxyroles/expressionrole.h"
+#include "proxyroles/predicaterole.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace JApp::Models;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Flat source model with an id, a name and a value per row, computed on the fly.
+class ContactModel : public QAbstractListModel
+{
+public:
+    enum Roles {
+        IdRole = Qt::UserRole + 1,
+        NameRole,
+        ValueRole
+    };
+
+    explicit ContactModel(int rowCount) : m_rowCount(rowCount) {}
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : m_rowCount;
+    }
+
+    QVariant data(const QModelIndex& index, int role) const override
+    {
+        switch (role) {
+            case IdRole: return index.row();
+            case NameRole: return QStringLiteral("Contact %1").arg((index.row() * 7919) % m_rowCount);
+            case ValueRole: return (index.row() * 31) % 1000;
+        }
+        return QVariant();
+    }
+
+    QHash<int, QByteArray> roleNames() const override
+    {
+        return { { IdRole, "id" }, { NameRole, "name" }, { ValueRole, "value" } };
+    }
+
+private:
+    int m_rowCount;
+};
+
+struct Scenario {
+    enum class Kind {
+        Filter,   // Times a filtering pass
+        Sorter,   // Times a sorting pass
+        ProxyRole // Times reading the "computed" role of every row
+    };
+
+    QString name;
+    Kind kind;
+    QByteArray declaration; // QML declaration of the only filter, sorter or proxy role of the proxy model
+    QByteArray proxyProperties; // Extra property bindings of the proxy model
+};
+
+struct Result {
+    QString error;
+    int acceptedRows = 0;
+    std::vector<qint64> durations; // Nanoseconds per full pass
+};
+
+// Registered under a benchmark module, so the benchmark doesn't depend on the startup functions being linked in.
+void registerTypes()
+{
+    qmlRegisterType<QQmlSortFilterProxyModel>("JAppModelBench", 1, 0, "SortFilterProxyModel");
+    qmlRegisterType<RangeFilter>("JAppModelBench", 1, 0, "RangeFilter");
+    qmlRegisterType<ExpressionFilter>("JAppModelBench", 1, 0, "ExpressionFilter");
+    qmlRegisterType<PredicateFilter>("JAppModelBench", 1, 0, "PredicateFilter");
+    qmlRegisterType<RoleSorter>("JAppModelBench", 1, 0, "RoleSorter");
+    qmlRegisterType<ExpressionSorter>("JAppModelBench", 1, 0, "ExpressionSorter");
+    qmlRegisterType<PredicateSorter>("JAppModelBench", 1, 0, "PredicateSorter");
+    qmlRegisterType<ExpressionRole>("JAppModelBench", 1, 0, "ExpressionRole");
+    qmlRegisterType<PredicateRole>("JAppModelBench", 1, 0, "PredicateRole");
+}
+
+QList<Scenario> createScenarios()
+{
+    using Kind = Scenario::Kind;
+    return {
+        { "RangeFilter",      Kind::Filter,    "RangeFilter { roleName: \"value\"; maximumValue: 499 }" },
+        { "ExpressionFilter", Kind::Filter,    "ExpressionFilter { expression: model.value < 500 && model.id % 2 === 0 }" },
+        { "PredicateFilter",  Kind::Filter,    "PredicateFilter { expression: \"model.value < 500 && model.id % 2 === 0\" }" },
+        { "ParallelRangeFilter",     Kind::Filter, "RangeFilter { roleName: \"value\"; maximumValue: 499 }", "parallelFiltering: true" },
+        { "ParallelPredicateFilter", Kind::Filter, "PredicateFilter { expression: \"model.value < 500 && model.id % 2 === 0\" }", "parallelFiltering: true" },
+        { "RoleSorter",       Kind::Sorter,    "RoleSorter { roleName: \"value\" }" },
+        { "ExpressionSorter", Kind::Sorter,    "ExpressionSorter { expression: modelLeft.value < modelRight.value }" },
+        { "PredicateSorter",  Kind::Sorter,    "PredicateSorter { expression: \"modelLeft.value < modelRight.value\" }" },
+        { "ExpressionKeySorter", Kind::Sorter, "ExpressionSorter { keyExpression: model.value }" },
+        { "ExpressionRole",   Kind::ProxyRole, "ExpressionRole { name: \"computed\"; expression: model.value * 2 + 1 }" },
+        { "PredicateRole",    Kind::ProxyRole, "PredicateRole { name: \"computed\"; expression: \"model.value * 2 + 1\" }" }
+    };
+}
+
+QByteArray propertyFor(Scenario::Kind kind)
+{
+    switch (kind) {
+        case Scenario::Kind::Filter: return "filters";
+        case Scenario::Kind::Sorter: return "sorters";
+        case Scenario::Kind::ProxyRole: return "proxyRoles";
+    }
+    return QByteArray();
+}
+
+// One full pass over the rows, the part that is timed.
+void runPass(const Scenario& scenario, QQmlSortFilterProxyModel& proxyModel, int computedRole)
+{
+    switch (scenario.kind) {
+        case Scenario::Kind::Filter:
+            proxyModel.filters().first()->setEnabled(true);
+            break;
+        case Scenario::Kind::Sorter:
+            proxyModel.sorters().first()->setEnabled(true);
+            break;
+        case Scenario::Kind::ProxyRole: {
+            const int rowCount = proxyModel.rowCount();
+            for (int row = 0; row < rowCount; ++row)
+                proxyModel.data(proxyModel.index(row, 0), computedRole);
+            break;
+        }
+    }
+}
+
+// Undoes the filtering or sorting of the previous pass, untimed.
+void resetPass(const Scenario& scenario, QQmlSortFilterProxyModel& proxyModel)
+{
+    switch (scenario.kind) {
+        case Scenario::Kind::Filter:
+            proxyModel.filters().first()->setEnabled(false);
+            break;
+        case Scenario::Kind::Sorter:
+            proxyModel.sorters().first()->setEnabled(false);
+            break;
+        case Scenario::Kind::ProxyRole:
+            break;
+    }
+}
+
+Result run(QQmlEngine& engine, const Scenario& scenario, ContactModel& sourceModel, int iterations)
+{
+    Result result;
+
+    QQmlComponent component(&engine);
+    component.setData("import JAppModelBench 1.0\nSortFilterProxyModel {\n    "
+                      + scenario.proxyProperties + "\n    "
+                      + propertyFor(scenario.kind) + ": " + scenario.declaration + "\n}\n", QUrl());
+    std::unique_ptr<QObject> object(component.create());
+    auto proxyModel = qobject_cast<QQmlSortFilterProxyModel*>(object.get());
+    if (!proxyModel) {
+        result.error = component.errorString();
+        return result;
+    }
+
+    // The first pass, when the source model is set, warms up caches and compiled code
+    proxyModel->setSourceModel(&sourceModel);
+    const int computedRole = proxyModel->roleForName("computed");
+
+    result.durations.reserve(iterations);
+    for (int i = 0; i < iterations; ++i) {
+        resetPass(scenario, *proxyModel);
+        const Clock::time_point start = Clock::now();
+        runPass(scenario, *proxyModel, computedRole);
+        result.durations.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+    result.acceptedRows = proxyModel->rowCount();
+
+    std::sort(result.durations.begin(), result.durations.end());
+    return result;
+}
+
+QJsonObject toJson(const Scenario& scenario, int rowCount, const Result& result)
+{
+    const double rows = qMax(1, rowCount);
+
+    QJsonObject nsPerRow;
+    nsPerRow["min"] = result.durations.front() / rows;
+    nsPerRow["p50"] = result.durations[result.durations.size() / 2] / rows;
+    nsPerRow["max"] = result.durations.back() / rows;
+
+    QJsonObject json;
+    json["scenario"] = scenario.name;
+    json["rows"] = rowCount;
+    json["acceptedRows"] = result.acceptedRows;
+    json["iterations"] = static_cast<int>(result.durations.size());
+    json["nsPerRow"] = nsPerRow;
+    return json;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("japp-modelbench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measures the per row cost of filtering, sorting and computing proxy roles on a flat source model.\n"
+                                     "Compare native and javascript variants on large models with e.g. -n 1000000 -i 3.");
+    parser.addHelpOption();
+
+    QCommandLineOption rowsOption({ "n", "rows" }, "Rows of the source model (default 50000).", "count", "50000");
+    QCommandLineOption iterationsOption({ "i", "iterations" }, "Filtering passes per scenario (default 20).", "count", "20");
+    QCommandLineOption outputOption({ "o", "output" }, "JSON results file (default japp-modelbench.json).", "file", "japp-modelbench.json");
+    QCommandLineOption labelOption({ "l", "label" }, "Free text stored with the results, e.g. a commit hash.", "label");
+    QCommandLineOption scenariosOption({ "s", "scenarios" }, "Comma separated scenarios to run (default: all).", "names");
+    parser.addOptions({ rowsOption, iterationsOption, outputOption, labelOption, scenariosOption });
+    parser.process(app);
+
+    QTextStream err(stderr);
+
+    bool ok = false;
+    const int rowCount = parser.value(rowsOption).toInt(&ok);
+    if (!ok || rowCount <= 0) {
+        err << "Invalid row count: " << parser.value(rowsOption) << Qt::endl;
+        return 1;
+    }
+
+    const int iterations = parser.value(iterationsOption).toInt(&ok);
+    if (!ok || iterations <= 0) {
+        err << "Invalid iteration count: " << parser.value(iterationsOption) << Qt::endl;
+        return 1;
+    }
+
+    registerTypes();
+    QQmlEngine engine;
+    ContactModel sourceModel(rowCount);
+
+    const QStringList selectedScenarios = parser.value(scenariosOption).split(',', Qt::SkipEmptyParts);
+
+    QJsonArray results;
+    for (const Scenario& scenario : createScenarios()) {
+        if (!selectedScenarios.isEmpty() && !selectedScenarios.contains(scenario.name))
+            continue;
+        err << scenario.name << ", " << rowCount << " rows" << Qt::endl;
+        const Result result = run(engine, scenario, sourceModel, iterations);
+        if (!result.error.isEmpty()) {
+            err << "Failed to create " << scenario.name << ": " << result.error << Qt::endl;
+            return 1;
+        }
+        results.append(toJson(scenario, rowCount, result));
+    }
+
+    QJsonObject report;
+    report["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    report["label"] = parser.value(labelOption);
+    report["results"] = results;
+
+    QFile output(parser.value(outputOption));
+    if (!output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        err << "Failed to open " << output.fileName() << Qt::endl;
+        return 1;
+    }
+    output.write(QJsonDocument(report).toJson());
+    return 0;
+}
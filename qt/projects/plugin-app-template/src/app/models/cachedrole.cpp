@@ -0,0 +1,29 @@
+#include "cachedrole.h"
+#include "qqmlsortfilterproxymodel.h"
+
+using namespace JApp::Models;
+
+CachedRole::CachedRole(const QString& name) : m_name(name)
+{
+}
+
+const QString& CachedRole::name() const
+{
+    return m_name;
+}
+
+void CachedRole::setName(const QString& name)
+{
+    m_name = name;
+    m_proxyModel = nullptr;
+}
+
+int CachedRole::role(const QQmlSortFilterProxyModel& proxyModel) const
+{
+    if (m_proxyModel != &proxyModel || m_rolesRevision != proxyModel.rolesRevision()) {
+        m_role = proxyModel.roleNames().key(m_name.toUtf8(), -1);
+        m_rolesRevision = proxyModel.rolesRevision();
+        m_proxyModel = &proxyModel;
+    }
+    return m_role;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <QString>
+
+namespace JApp::Models {
+
+class QQmlSortFilterProxyModel;
+
+// A role name and its role number in a proxy model. The number is looked up again only
+// when the proxy's roles change, so reading it per row is a couple of integer comparisons.
+class CachedRole
+{
+public:
+    CachedRole() = default;
+    explicit CachedRole(const QString& name);
+
+    const QString& name() const;
+    void setName(const QString& name);
+
+    // Role number for the name, -1 if the proxy has no such role.
+    int role(const QQmlSortFilterProxyModel& proxyModel) const;
+
+private:
+    QString m_name;
+    mutable const QQmlSortFilterProxyModel* m_proxyModel = nullptr;
+    mutable int m_rolesRevision = -1;
+    mutable int m_role = -1;
+};
+
+}
@@ -36,6 +36,12 @@ using namespace JApp::Models;
     \endcode
     \sa FilterContainer
 */
+Filter::Change AnyOfFilter::childEnabledChange(bool enabled) const
+{
+    // Disabled children are skipped: enabling one adds the rows it accepts
+    return enabled ? Change::Widening : Change::Narrowing;
+}
+
 bool AnyOfFilter::filterRow(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const
 {
     //return true if any of the enabled filters return true
@@ -11,6 +11,7 @@ public:
     using FilterContainerFilter::FilterContainerFilter;
 
 protected:
+    Change childEnabledChange(bool enabled) const override;
     bool filterRow(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const override;
 };
 
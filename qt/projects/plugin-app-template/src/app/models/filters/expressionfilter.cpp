@@ -1,5 +1,6 @@
 #include "expressionfilter.h"
 #include "qqmlsortfilterproxymodel.h"
+#include "lazyrowmodel.h"
 #include <QtQml>
 
 using namespace JApp::Models;
@@ -21,6 +22,7 @@ using namespace JApp::Models;
     It has the same syntax has a \l {http://doc.qt.io/qt-5/qtqml-syntax-propertybinding.html} {Property Binding} except it will be evaluated for each of the source model's rows.
     Rows that have their expression evaluating to \c true will be accepted by the model.
     Data for each row is exposed like for a delegate of a QML View.
+    Unless the source model has a \c get() method, the roles of \c model are read from the source model when the expression accesses them.
 
     This expression is reevaluated for a row every time its model data changes.
     When an external property (not \c index or in \c model) the expression depends on changes, the expression is reevaluated for every row of the source model.
@@ -40,6 +42,7 @@ void ExpressionFilter::setExpression(const QQmlScriptString& scriptString)
         return;
 
     m_scriptString = scriptString;
+    deleteRowExpression();
     updateExpression();
 
     Q_EMIT expressionChanged();
@@ -54,26 +57,36 @@ void ExpressionFilter::proxyModelCompleted(const QQmlSortFilterProxyModel& proxy
 bool ExpressionFilter::filterRow(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const
 {
     if (!m_scriptString.isEmpty()) {
-        const QVariant modelMap = proxyModel.sourceData(sourceIndex);
-        QQmlContext context(qmlContext(this));
-        context.setContextProperty("index", sourceIndex.row());
-        context.setContextProperty("modelIndex", sourceIndex.row());
-        context.setContextProperty("model", modelMap);
+        QQmlExpression* expression = rowExpression();
+        if (proxyModel.hasSourceGetMethod()) {
+            // What get() returns can't be read role by role
+            m_rowContext->setContextProperty("model", proxyModel.sourceData(sourceIndex));
+            m_rowModelBound = false;
+        } else {
+            m_rowModel->setRow(proxyModel, sourceIndex);
+            if (!m_rowModelBound) {
+                if (QQmlEngine* engine = m_rowContext->engine())
+                    m_rowContext->setContextProperty("model", QVariant::fromValue(m_rowModel->createModelObject(*engine)));
+                m_rowModelBound = true;
+            }
+        }
+        m_rowContext->setContextProperty("index", sourceIndex.row());
+        m_rowContext->setContextProperty("modelIndex", sourceIndex.row());
 
-        QQmlExpression expression(m_scriptString, &context);
-        QVariant variantResult = expression.evaluate();
+        expression->clearError();
+        QVariant variantResult = expression->evaluate();
 
-        if (expression.hasError()) {
-            qWarning() << expression.error();
+        if (expression->hasError()) {
+            qWarning() << expression->error();
             return true;
         }
         if (variantResult.canConvert<bool>()) {
             return variantResult.toBool();
         } else {
             qWarning("%s:%i:%i : Can't convert result to bool",
-                     expression.sourceFile().toUtf8().data(),
-                     expression.lineNumber(),
-                     expression.columnNumber());
+                     expression->sourceFile().toUtf8().data(),
+                     expression->lineNumber(),
+                     expression->columnNumber());
             return true;
         }
     }
@@ -101,6 +114,27 @@ void ExpressionFilter::updateContext(const QQmlSortFilterProxyModel& proxyModel)
     updateExpression();
 }
 
+QQmlExpression* ExpressionFilter::rowExpression() const
+{
+    if (!m_rowExpression) {
+        // Filters are only evaluated from the proxy model's thread, so one context can be reused for every row
+        auto self = const_cast<ExpressionFilter*>(this);
+        if (!m_rowContext) {
+            m_rowContext = new QQmlContext(qmlContext(this), self);
+            // Without a get() method, the same model object serves every row, it reads the roles of the row set with setRow()
+            m_rowModel = new LazyRowModel(self);
+        }
+        m_rowExpression = new QQmlExpression(m_scriptString, m_rowContext, nullptr, self);
+    }
+    return m_rowExpression;
+}
+
+void ExpressionFilter::deleteRowExpression()
+{
+    delete m_rowExpression;
+    m_rowExpression = nullptr;
+}
+
 void ExpressionFilter::updateExpression()
 {
     if (!m_context)
@@ -7,6 +7,8 @@ class QQmlExpression;
 
 namespace JApp::Models {
 
+class LazyRowModel;
+
 class ExpressionFilter : public Filter
 {
     Q_OBJECT
@@ -29,10 +31,18 @@ Q_SIGNALS:
 private:
     void updateContext(const QQmlSortFilterProxyModel& proxyModel);
     void updateExpression();
+    QQmlExpression* rowExpression() const;
+    void deleteRowExpression();
 
     QQmlScriptString m_scriptString;
     QQmlExpression* m_expression = nullptr;
     QQmlContext* m_context = nullptr;
+
+    // Evaluates the expression for each row, created once and rebound to every row
+    mutable QQmlContext* m_rowContext = nullptr;
+    mutable QQmlExpression* m_rowExpression = nullptr;
+    mutable LazyRowModel* m_rowModel = nullptr;
+    mutable bool m_rowModelBound = false; // Whether the row context's model is m_rowModel's object
 };
 
 }
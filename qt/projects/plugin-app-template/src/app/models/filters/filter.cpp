@@ -39,8 +39,10 @@ void Filter::setEnabled(bool enabled)
         return;
 
     m_enabled = enabled;
+    // Before invalidated(), filter containers rely on that order
     Q_EMIT enabledChanged();
-    Q_EMIT invalidated();
+    // A disabled filter accepts every row
+    Q_EMIT invalidated(enabled ? Change::Narrowing : Change::Widening);
 }
 
 /*!
@@ -76,8 +78,39 @@ void Filter::proxyModelCompleted(const QQmlSortFilterProxyModel& proxyModel)
     Q_UNUSED(proxyModel)
 }
 
+void Filter::appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const
+{
+    Q_UNUSED(proxyModel)
+    Q_UNUSED(roles)
+}
+
+bool Filter::isThreadSafe() const
+{
+    return false;
+}
+
 void Filter::invalidate()
 {
-    if (m_enabled)
-        Q_EMIT invalidated();
+    emitInvalidated(Change::Any);
+}
+
+void Filter::invalidateNarrowed()
+{
+    emitInvalidated(Change::Narrowing);
+}
+
+void Filter::invalidateWidened()
+{
+    emitInvalidated(Change::Widening);
+}
+
+void Filter::emitInvalidated(Change change)
+{
+    if (!m_enabled)
+        return;
+
+    // Narrowing what an inverted filter matches widens what it accepts
+    if (m_inverted && change != Change::Any)
+        change = change == Change::Narrowing ? Change::Widening : Change::Narrowing;
+    Q_EMIT invalidated(change);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QObject>
+#include <QVector>
 
 namespace JApp::Models {
 
@@ -13,6 +14,14 @@ class Filter : public QObject
     Q_PROPERTY(bool inverted READ inverted WRITE setInverted NOTIFY invertedChanged)
 
 public:
+    // How a change of the filter affects the rows it accepts.
+    enum class Change {
+        Any,
+        Narrowing, // Can only reject rows that were accepted
+        Widening   // Can only accept rows that were rejected
+    };
+    Q_ENUM(Change)
+
     explicit Filter(QObject *parent = nullptr);
     virtual ~Filter() = default;
 
@@ -26,16 +35,30 @@ public:
 
     virtual void proxyModelCompleted(const QQmlSortFilterProxyModel& proxyModel);
 
+    // Source roles read by filterRow(), cached by the proxy model when cacheRoles is set.
+    virtual void appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const;
+
+    // Whether filterRow() can run on worker threads while the proxy model waits for them, see parallelFiltering.
+    // It must then read row data only through the proxy model's sourceData(), never call the source model
+    // itself (not even rowCount()) and change no state.
+    virtual bool isThreadSafe() const;
+
 Q_SIGNALS:
     void enabledChanged();
     void invertedChanged();
-    void invalidated();
+    void invalidated(JApp::Models::Filter::Change change);
 
 protected:
     virtual bool filterRow(const QModelIndex &sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const = 0;
     void invalidate();
 
+    // Let the proxy model retest only accepted or only rejected rows.
+    void invalidateNarrowed();
+    void invalidateWidened();
+
 private:
+    void emitInvalidated(Change change);
+
     bool m_enabled = true;
     bool m_inverted = false;
 };
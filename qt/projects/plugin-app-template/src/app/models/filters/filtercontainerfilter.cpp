@@ -1,4 +1,5 @@
 #include "filtercontainerfilter.h"
+#include <algorithm>
 
 using namespace JApp::Models;
 
@@ -8,15 +9,55 @@ void FilterContainerFilter::proxyModelCompleted(const QQmlSortFilterProxyModel&
         filter->proxyModelCompleted(proxyModel);
 }
 
+void FilterContainerFilter::appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const
+{
+    for (Filter* filter : m_filters) {
+        if (filter->enabled())
+            filter->appendUsedRoles(proxyModel, roles);
+    }
+}
+
+bool FilterContainerFilter::isThreadSafe() const
+{
+    return std::all_of(m_filters.begin(), m_filters.end(), [] (Filter* filter) {
+        return !filter->enabled() || filter->isThreadSafe();
+    });
+}
+
+Filter::Change FilterContainerFilter::childEnabledChange(bool enabled) const
+{
+    return enabled ? Change::Narrowing : Change::Widening;
+}
+
+void FilterContainerFilter::onFilterInvalidated(Filter* filter, Filter::Change change)
+{
+    // AllOf and AnyOf narrow or widen along with their filters, except when they are enabled or disabled
+    if (filter == m_enablingFilter) {
+        m_enablingFilter = nullptr;
+        change = childEnabledChange(filter->enabled());
+    }
+
+    switch (change) {
+        case Change::Narrowing: invalidateNarrowed(); break;
+        case Change::Widening: invalidateWidened(); break;
+        case Change::Any: invalidate(); break;
+    }
+}
+
 void FilterContainerFilter::onFilterAppended(Filter* filter)
 {
-    connect(filter, &Filter::invalidated, this, &FilterContainerFilter::invalidate);
+    connect(filter, &Filter::enabledChanged, this, [this, filter] {
+        m_enablingFilter = filter;
+    });
+    connect(filter, &Filter::invalidated, this, [this, filter] (Filter::Change change) {
+        onFilterInvalidated(filter, change);
+    });
     invalidate();
 }
 
 void FilterContainerFilter::onFilterRemoved(Filter* filter)
 {
-    Q_UNUSED(filter)
+    disconnect(filter, nullptr, this, nullptr);
     invalidate();
 }
 
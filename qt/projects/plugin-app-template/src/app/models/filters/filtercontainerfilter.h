@@ -15,14 +15,25 @@ public:
     using Filter::Filter;
 
     void proxyModelCompleted(const QQmlSortFilterProxyModel& proxyModel) override;
+    void appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const override;
+    bool isThreadSafe() const override;
 
 Q_SIGNALS:
     void filtersChanged();
 
+protected:
+    // How enabling or disabling a child filter changes the rows this filter accepts.
+    // Disabled children accept every row, so by default enabling narrows.
+    virtual Change childEnabledChange(bool enabled) const;
+
 private:
+    void onFilterInvalidated(Filter* filter, JApp::Models::Filter::Change change);
     void onFilterAppended(Filter* filter) override;
     void onFilterRemoved(Filter* filter) override;
     void onFiltersCleared() override;
+
+    // Child whose enabledChanged() was just emitted, its invalidated() signal follows
+    Filter* m_enablingFilter = nullptr;
 };
 
 }
@@ -4,6 +4,7 @@
 #include "regexpfilter.h"
 #include "rangefilter.h"
 #include "expressionfilter.h"
+#include "predicatefilter.h"
 #include "anyoffilter.h"
 #include "alloffilter.h"
 #include <QQmlEngine>
@@ -18,6 +19,7 @@ void registerFiltersTypes() {
     qmlRegisterType<RegExpFilter>("SortFilterProxyModel", 0, 2, "RegExpFilter");
     qmlRegisterType<RangeFilter>("SortFilterProxyModel", 0, 2, "RangeFilter");
     qmlRegisterType<ExpressionFilter>("SortFilterProxyModel", 0, 2, "ExpressionFilter");
+    qmlRegisterType<PredicateFilter>("SortFilterProxyModel", 0, 2, "PredicateFilter");
     qmlRegisterType<AnyOfFilter>("SortFilterProxyModel", 0, 2, "AnyOf");
     qmlRegisterType<AllOfFilter>("SortFilterProxyModel", 0, 2, "AllOf");
     qmlRegisterUncreatableType<FilterContainerAttached>("SortFilterProxyModel", 0, 2, "FilterContainer", "FilterContainer can only be used as an attaching type");
@@ -0,0 +1,73 @@
+#include "predicatefilter.h"
+#include "qqmlsortfilterproxymodel.h"
+#include <JApp/Log.h>
+
+using namespace JApp::Models;
+
+/*!
+    \qmltype PredicateFilter
+    \inherits Filter
+    \inqmlmodule SortFilterProxyModel
+    \ingroup Filters
+    \brief Filters rows with a native predicate expression.
+
+    A PredicateFilter is a \l Filter accepting rows for which a predicate expression is true.
+    Unlike \l ExpressionFilter, the expression is a string compiled once by the model and evaluated without the javascript engine,
+    which makes it much cheaper per row.
+
+    In the following example, only adults with an open status are accepted :
+    \code
+    SortFilterProxyModel {
+       sourceModel: contactModel
+       filters: PredicateFilter {
+           expression: "model.age > 18 && model.status === 'open'"
+       }
+    }
+    \endcode
+*/
+
+/*!
+    \qmlproperty string PredicateFilter::expression
+
+    The predicate deciding whether a row is accepted.
+    Roles of the row are read with \c model.role or simply \c role, and its index with \c index.
+    The expression supports number, string, \c true, \c false and \c null literals, the \c ?: \c || \c && \c == \c != \c === \c !==
+    \c < \c <= \c > \c >= \c + \c - \c * \c / \c % \c ! operators and parentheses.
+    Values are never converted implicitly: \c {1 == "1"} is \c false, and so is any comparison between values of different types.
+
+    Rows are accepted when the expression is empty or doesn't parse, in which case a warning is logged.
+    Unlike \l ExpressionFilter, the expression can't refer to QML properties.
+*/
+const QString& PredicateFilter::expression() const
+{
+    return m_predicate.source();
+}
+
+void PredicateFilter::setExpression(const QString& expression)
+{
+    if (m_predicate.source() == expression)
+        return;
+
+    if (!m_predicate.compile(expression))
+        LOG_WARN() << "Failed to parse predicate" << expression << ":" << m_predicate.errorString();
+
+    Q_EMIT expressionChanged();
+    invalidate();
+}
+
+void PredicateFilter::appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const
+{
+    m_predicate.appendUsedRoles(proxyModel, roles);
+}
+
+bool PredicateFilter::isThreadSafe() const
+{
+    return true;
+}
+
+bool PredicateFilter::filterRow(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const
+{
+    if (m_predicate.isEmpty())
+        return true;
+    return m_predicate.evaluate(sourceIndex, proxyModel).isTruthy();
+}
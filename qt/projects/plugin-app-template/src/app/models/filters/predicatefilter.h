@@ -0,0 +1,32 @@
+#pragma once
+
+#include "filter.h"
+#include "predicate.h"
+
+namespace JApp::Models {
+
+class PredicateFilter : public Filter
+{
+    Q_OBJECT
+    Q_PROPERTY(QString expression READ expression WRITE setExpression NOTIFY expressionChanged)
+
+public:
+    using Filter::Filter;
+
+    const QString& expression() const;
+    void setExpression(const QString& expression);
+
+    void appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const override;
+    bool isThreadSafe() const override;
+
+protected:
+    bool filterRow(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const override;
+
+Q_SIGNALS:
+    void expressionChanged();
+
+private:
+    Predicate m_predicate;
+};
+
+}
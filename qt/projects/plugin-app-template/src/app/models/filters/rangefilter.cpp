@@ -3,6 +3,18 @@
 
 using namespace JApp::Models;
 
+namespace {
+
+// Bounds of different types may order rows differently, their change is neither narrowing nor widening
+QPartialOrdering compareBounds(const QVariant& newBound, const QVariant& oldBound)
+{
+    if (newBound.metaType() != oldBound.metaType())
+        return QPartialOrdering::Unordered;
+    return QVariant::compare(newBound, oldBound);
+}
+
+}
+
 /*!
     \qmltype RangeFilter
     \inherits RoleFilter
@@ -55,9 +67,16 @@ void RangeFilter::setMinimumValue(QVariant minimumValue)
     if (m_minimumValue == minimumValue)
         return;
 
+    // A higher minimum can only reject more rows, no minimum is the lowest one
+    const QPartialOrdering ordering = m_minimumValue.isValid() ? compareBounds(minimumValue, m_minimumValue) : QPartialOrdering::Greater;
     m_minimumValue = minimumValue;
     Q_EMIT minimumValueChanged();
-    invalidate();
+    if (ordering == QPartialOrdering::Greater)
+        invalidateNarrowed();
+    else if (ordering == QPartialOrdering::Less)
+        invalidateWidened();
+    else
+        invalidate();
 }
 
 /*!
@@ -81,7 +100,10 @@ void RangeFilter::setMinimumInclusive(bool minimumInclusive)
 
     m_minimumInclusive = minimumInclusive;
     Q_EMIT minimumInclusiveChanged();
-    invalidate();
+    if (minimumInclusive)
+        invalidateWidened();
+    else
+        invalidateNarrowed();
 }
 
 /*!
@@ -110,9 +132,16 @@ void RangeFilter::setMaximumValue(QVariant maximumValue)
     if (m_maximumValue == maximumValue)
         return;
 
+    // A lower maximum can only reject more rows, no maximum is the highest one
+    const QPartialOrdering ordering = m_maximumValue.isValid() ? compareBounds(maximumValue, m_maximumValue) : QPartialOrdering::Less;
     m_maximumValue = maximumValue;
     Q_EMIT maximumValueChanged();
-    invalidate();
+    if (ordering == QPartialOrdering::Less)
+        invalidateNarrowed();
+    else if (ordering == QPartialOrdering::Greater)
+        invalidateWidened();
+    else
+        invalidate();
 }
 
 /*!
@@ -136,26 +165,39 @@ void RangeFilter::setMaximumInclusive(bool maximumInclusive)
 
     m_maximumInclusive = maximumInclusive;
     Q_EMIT maximumInclusiveChanged();
-    invalidate();
+    if (maximumInclusive)
+        invalidateWidened();
+    else
+        invalidateNarrowed();
 }
 
 bool RangeFilter::filterRow(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const
 {
     const QVariant value = sourceData(sourceIndex, proxyModel);
-    QPartialOrdering minComparisonResult = QVariant::compare(value, m_minimumValue);
-    QPartialOrdering maxComparisonResult = QVariant::compare(m_maximumValue, value);
 
-    if (minComparisonResult == QPartialOrdering::Unordered)
-    {
-        LOG_WARN() << "Failed to filter row with value " << value << ", comparison failed with minimum value " << m_minimumValue;
-    }
-    if (maxComparisonResult == QPartialOrdering::Unordered)
-    {
-        LOG_WARN() << "Failed to filter row with value " << value << ", comparison failed with minimum value " << m_minimumValue;
+    // Unset bounds don't reject anything
+    if (m_minimumValue.isValid()) {
+        QPartialOrdering minComparisonResult = QVariant::compare(value, m_minimumValue);
+        if (minComparisonResult == QPartialOrdering::Unordered)
+        {
+            LOG_WARN() << "Failed to filter row with value " << value << ", comparison failed with minimum value " << m_minimumValue;
+        }
+        bool isLessThanMin = m_minimumInclusive ? minComparisonResult == QPartialOrdering::Less : (minComparisonResult == QPartialOrdering::Equivalent || minComparisonResult == QPartialOrdering::Less);
+        if (isLessThanMin)
+            return false;
     }
 
-    bool isLessThanMin = m_minimumInclusive ? (minComparisonResult == QPartialOrdering::Equivalent || minComparisonResult == QPartialOrdering::Less) : minComparisonResult == QPartialOrdering::Less;
-    bool isGreaterThanMax = m_maximumInclusive ? (maxComparisonResult == QPartialOrdering::Equivalent || minComparisonResult == QPartialOrdering::Greater) : minComparisonResult == QPartialOrdering::Greater;
+    if (m_maximumValue.isValid()) {
+        QPartialOrdering maxComparisonResult = QVariant::compare(value, m_maximumValue);
+        if (maxComparisonResult == QPartialOrdering::Unordered)
+        {
+            LOG_WARN() << "Failed to filter row with value " << value << ", comparison failed with maximum value " << m_maximumValue;
+        }
+        bool isGreaterThanMax = m_maximumInclusive ? maxComparisonResult == QPartialOrdering::Greater : (maxComparisonResult == QPartialOrdering::Equivalent || maxComparisonResult == QPartialOrdering::Greater);
+        if (isGreaterThanMax)
+            return false;
+    }
 
-    return !(isLessThanMin || isGreaterThanMax);
+    return true;
 }
+
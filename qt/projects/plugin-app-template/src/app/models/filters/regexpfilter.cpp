@@ -53,6 +53,8 @@ void RegExpFilter::setPattern(const QString& pattern)
 
     m_pattern = pattern;
     m_regExp.setPattern(pattern);
+    // Compiled here rather than on the first match, which can run on a parallel filtering thread
+    m_regExp.optimize();
     Q_EMIT patternChanged();
     invalidate();
 }
@@ -77,6 +79,7 @@ void RegExpFilter::setCaseSensitivity(Qt::CaseSensitivity caseSensitivity)
     if (caseSensitivity == Qt::CaseInsensitive)
         patternOptions.setFlag(QRegularExpression::CaseInsensitiveOption);
     m_regExp.setPatternOptions(patternOptions);
+    m_regExp.optimize();
     Q_EMIT caseSensitivityChanged();
     invalidate();
 }
@@ -24,20 +24,30 @@ using namespace JApp::Models;
 */
 const QString& RoleFilter::roleName() const
 {
-    return m_roleName;
+    return m_role.name();
 }
 
 void RoleFilter::setRoleName(const QString& roleName)
 {
-    if (m_roleName == roleName)
+    if (m_role.name() == roleName)
         return;
 
-    m_roleName = roleName;
+    m_role.setName(roleName);
     Q_EMIT roleNameChanged();
     invalidate();
 }
 
+void RoleFilter::appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const
+{
+    roles.append(m_role.role(proxyModel));
+}
+
+bool RoleFilter::isThreadSafe() const
+{
+    return true;
+}
+
 QVariant RoleFilter::sourceData(const QModelIndex &sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const
 {
-    return proxyModel.sourceData(sourceIndex, m_roleName);
+    return proxyModel.sourceData(sourceIndex, m_role.role(proxyModel));
 }
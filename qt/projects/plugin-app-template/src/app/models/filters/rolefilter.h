@@ -1,6 +1,7 @@
 #pragma once
 
 #include "filter.h"
+#include "cachedrole.h"
 
 namespace JApp::Models {
 
@@ -15,6 +16,9 @@ public:
     const QString& roleName() const;
     void setRoleName(const QString& roleName);
 
+    void appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const override;
+    bool isThreadSafe() const override;
+
 Q_SIGNALS:
     void roleNameChanged();
 
@@ -22,7 +26,7 @@ protected:
     QVariant sourceData(const QModelIndex &sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const;
 
 private:
-    QString m_roleName;
+    CachedRole m_role;
 };
 
 }
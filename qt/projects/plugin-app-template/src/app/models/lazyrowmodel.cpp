@@ -0,0 +1,66 @@
+#include "lazyrowmodel.h"
+#include "qqmlsortfilterproxymodel.h"
+#include <QJSEngine>
+
+using namespace JApp::Models;
+
+void LazyRowModel::setRow(const QQmlSortFilterProxyModel& proxyModel, const QModelIndex& sourceIndex)
+{
+    if (m_proxyModel != &proxyModel) {
+        m_proxyModel = &proxyModel;
+        m_rolesRevision = -1;
+    }
+    m_sourceIndex = sourceIndex;
+}
+
+QJSValue LazyRowModel::createModelObject(QJSEngine& engine)
+{
+    // Names that aren't roles fall back to the plain object, so e.g. model.toString still works
+    QJSValue factory = engine.evaluate(QStringLiteral(
+        "(function (row) {\n"
+        "    return new Proxy({}, {\n"
+        "        get: function (target, name) {\n"
+        "            if (typeof name !== 'string')\n"
+        "                return target[name];\n"
+        "            var value = row.value(name);\n"
+        "            return value !== undefined ? value : target[name];\n"
+        "        },\n"
+        "        has: function (target, name) {\n"
+        "            return typeof name === 'string' && row.hasRole(name);\n"
+        "        }\n"
+        "    });\n"
+        "})"));
+    return factory.call({ engine.newQObject(this) });
+}
+
+QVariant LazyRowModel::value(const QString& roleName)
+{
+    // Like in the map of sourceData(), index is the source row even if a role has that name
+    if (roleName == QLatin1String("index"))
+        return m_sourceIndex.row();
+    const int roleNumber = role(roleName);
+    if (roleNumber < 0)
+        return QVariant();
+    return m_proxyModel->sourceData(m_sourceIndex, roleNumber);
+}
+
+bool LazyRowModel::hasRole(const QString& roleName)
+{
+    return roleName == QLatin1String("index") || role(roleName) >= 0;
+}
+
+int LazyRowModel::role(const QString& roleName)
+{
+    if (!m_proxyModel)
+        return -1;
+
+    // Looking a role up by name scans every role, so names are resolved once per roles revision
+    if (m_rolesRevision != m_proxyModel->rolesRevision()) {
+        m_roles.clear();
+        m_rolesRevision = m_proxyModel->rolesRevision();
+    }
+    auto it = m_roles.constFind(roleName);
+    if (it == m_roles.cend())
+        it = m_roles.insert(roleName, m_proxyModel->roleForName(roleName));
+    return it.value();
+}
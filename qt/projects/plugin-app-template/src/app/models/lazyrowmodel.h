@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QHash>
+#include <QJSValue>
+#include <QModelIndex>
+#include <QObject>
+#include <QVariant>
+
+class QJSEngine;
+
+namespace JApp::Models {
+
+class QQmlSortFilterProxyModel;
+
+// The model object of one row for javascript expressions. model.role reads that role from the proxy
+// model when the expression accesses it, instead of every role of every row being copied into a map.
+// It is rebound to each row with setRow() before the expression is evaluated.
+class LazyRowModel : public QObject
+{
+    Q_OBJECT
+
+public:
+    using QObject::QObject;
+
+    void setRow(const QQmlSortFilterProxyModel& proxyModel, const QModelIndex& sourceIndex);
+
+    // A javascript object reading the current row's roles through value().
+    QJSValue createModelObject(QJSEngine& engine);
+
+    Q_INVOKABLE QVariant value(const QString& roleName);
+    Q_INVOKABLE bool hasRole(const QString& roleName);
+
+private:
+    int role(const QString& roleName);
+
+    const QQmlSortFilterProxyModel* m_proxyModel = nullptr;
+    QModelIndex m_sourceIndex;
+    QHash<QString, int> m_roles;
+    int m_rolesRevision = -1;
+};
+
+}
@@ -0,0 +1,662 @@
+#include "predicate.h"
+#include "qqmlsortfilterproxymodel.h"
+#include <QLocale>
+#include <QVarLengthArray>
+#include <cmath>
+
+using namespace JApp::Models;
+
+Predicate::Value::Value(bool value) :
+    m_type(Type::Bool),
+    m_number(value ? 1 : 0)
+{
+}
+
+Predicate::Value::Value(double value) :
+    m_type(Type::Number),
+    m_number(value)
+{
+}
+
+Predicate::Value::Value(const QString& value) :
+    m_type(Type::String),
+    m_string(value)
+{
+}
+
+Predicate::Value Predicate::Value::fromVariant(const QVariant& variant)
+{
+    switch (variant.typeId()) {
+        case QMetaType::UnknownType:
+        case QMetaType::Nullptr:
+            return Value();
+        case QMetaType::Bool:
+            return Value(variant.toBool());
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Short:
+        case QMetaType::UShort:
+        case QMetaType::Long:
+        case QMetaType::ULong:
+        case QMetaType::Char:
+        case QMetaType::SChar:
+        case QMetaType::UChar:
+        case QMetaType::Double:
+        case QMetaType::Float:
+            return Value(variant.toDouble());
+        case QMetaType::QString:
+            return Value(variant.toString());
+        default:
+            return variant.canConvert<QString>() ? Value(variant.toString()) : Value();
+    }
+}
+
+QVariant Predicate::Value::toVariant() const
+{
+    switch (m_type) {
+        case Type::Bool: return m_number != 0;
+        case Type::Number: return m_number;
+        case Type::String: return m_string;
+        case Type::Null: break;
+    }
+    return QVariant();
+}
+
+Predicate::Value::Type Predicate::Value::type() const
+{
+    return m_type;
+}
+
+bool Predicate::Value::isTruthy() const
+{
+    switch (m_type) {
+        case Type::Bool: return m_number != 0;
+        case Type::Number: return m_number != 0 && !std::isnan(m_number);
+        case Type::String: return !m_string.isEmpty();
+        case Type::Null: break;
+    }
+    return false;
+}
+
+double Predicate::Value::number() const
+{
+    return m_number;
+}
+
+const QString& Predicate::Value::string() const
+{
+    return m_string;
+}
+
+QString Predicate::Value::toString() const
+{
+    switch (m_type) {
+        case Type::Bool: return m_number != 0 ? QStringLiteral("true") : QStringLiteral("false");
+        case Type::Number: return QString::number(m_number, 'g', QLocale::FloatingPointShortest);
+        case Type::String: return m_string;
+        case Type::Null: break;
+    }
+    return QStringLiteral("null");
+}
+
+namespace JApp::Models {
+
+// Recursive descent parser emitting bytecode as it goes, one function per precedence level.
+class PredicateCompiler
+{
+public:
+    PredicateCompiler(const QString& source, Predicate& predicate) :
+        m_source(source),
+        m_predicate(predicate)
+    {
+    }
+
+    bool compile()
+    {
+        next();
+        parseConditional();
+        if (m_error.isEmpty() && m_token.type != TokenType::End)
+            fail(QStringLiteral("unexpected '%1'").arg(m_token.text));
+        if (!m_error.isEmpty()) {
+            m_predicate.m_errorString = m_error;
+            return false;
+        }
+        m_predicate.m_stackSize = m_maxDepth;
+        return true;
+    }
+
+private:
+    enum class TokenType {
+        End,
+        Number,
+        String,
+        Identifier,
+        Operator
+    };
+
+    struct Token {
+        TokenType type = TokenType::End;
+        QString text;
+        double number = 0;
+        int position = 0;
+    };
+
+    void fail(const QString& message)
+    {
+        if (m_error.isEmpty())
+            m_error = QStringLiteral("%1 at position %2").arg(message).arg(m_token.position + 1);
+    }
+
+    void next()
+    {
+        while (m_position < m_source.size() && m_source.at(m_position).isSpace())
+            ++m_position;
+
+        m_token = Token();
+        m_token.position = m_position;
+        if (m_position >= m_source.size())
+            return;
+
+        const QChar c = m_source.at(m_position);
+        if (c.isDigit() || (c == '.' && m_position + 1 < m_source.size() && m_source.at(m_position + 1).isDigit())) {
+            const int start = m_position;
+            while (m_position < m_source.size() && (m_source.at(m_position).isDigit() || m_source.at(m_position) == '.'))
+                ++m_position;
+            if (m_position < m_source.size() && (m_source.at(m_position) == 'e' || m_source.at(m_position) == 'E')) {
+                ++m_position;
+                if (m_position < m_source.size() && (m_source.at(m_position) == '+' || m_source.at(m_position) == '-'))
+                    ++m_position;
+                while (m_position < m_source.size() && m_source.at(m_position).isDigit())
+                    ++m_position;
+            }
+            m_token.type = TokenType::Number;
+            m_token.text = m_source.mid(start, m_position - start);
+            bool ok = false;
+            m_token.number = m_token.text.toDouble(&ok);
+            if (!ok)
+                fail(QStringLiteral("invalid number '%1'").arg(m_token.text));
+            return;
+        }
+
+        if (c == '"' || c == '\'') {
+            ++m_position;
+            QString text;
+            while (m_position < m_source.size() && m_source.at(m_position) != c) {
+                QChar character = m_source.at(m_position++);
+                if (character == '\\' && m_position < m_source.size()) {
+                    character = m_source.at(m_position++);
+                    if (character == 'n')
+                        character = '\n';
+                    else if (character == 't')
+                        character = '\t';
+                }
+                text.append(character);
+            }
+            if (m_position >= m_source.size()) {
+                fail(QStringLiteral("unterminated string"));
+                return;
+            }
+            ++m_position;
+            m_token.type = TokenType::String;
+            m_token.text = text;
+            return;
+        }
+
+        if (c.isLetter() || c == '_' || c == '$') {
+            const int start = m_position;
+            while (m_position < m_source.size() && (m_source.at(m_position).isLetterOrNumber() || m_source.at(m_position) == '_' || m_source.at(m_position) == '$'))
+                ++m_position;
+            m_token.type = TokenType::Identifier;
+            m_token.text = m_source.mid(start, m_position - start);
+            return;
+        }
+
+        // Longest operator first
+        static const char* const Operators[] = {
+            "===", "!==", "==", "!=", "<=", ">=", "&&", "||",
+            "<", ">", "!", "+", "-", "*", "/", "%", "(", ")", "?", ":", "."
+        };
+        for (const char* op : Operators) {
+            const QLatin1String view(op);
+            if (QStringView(m_source).mid(m_position).startsWith(view)) {
+                m_position += view.size();
+                m_token.type = TokenType::Operator;
+                m_token.text = view.toString();
+                return;
+            }
+        }
+        m_token.type = TokenType::Operator;
+        m_token.text = c;
+        ++m_position;
+        fail(QStringLiteral("unexpected '%1'").arg(c));
+    }
+
+    bool accept(const char* op)
+    {
+        if (m_token.type == TokenType::Operator && m_token.text == QLatin1String(op)) {
+            next();
+            return true;
+        }
+        return false;
+    }
+
+    void expect(const char* op)
+    {
+        if (!accept(op))
+            fail(QStringLiteral("expected '%1'").arg(QLatin1String(op)));
+    }
+
+    int emit(Predicate::OpCode opCode, int operand = 0, Predicate::Side side = Predicate::Left)
+    {
+        m_predicate.m_code.push_back({ opCode, side, operand });
+        return static_cast<int>(m_predicate.m_code.size()) - 1;
+    }
+
+    void push(Predicate::OpCode opCode, int operand = 0, Predicate::Side side = Predicate::Left)
+    {
+        emit(opCode, operand, side);
+        m_maxDepth = qMax(m_maxDepth, ++m_depth);
+    }
+
+    void binary(Predicate::OpCode opCode)
+    {
+        emit(opCode);
+        --m_depth;
+    }
+
+    void patchJump(int instruction)
+    {
+        m_predicate.m_code[instruction].operand = static_cast<int>(m_predicate.m_code.size());
+    }
+
+    int roleIndex(const QString& name)
+    {
+        auto& roles = m_predicate.m_roles;
+        for (size_t i = 0; i < roles.size(); ++i) {
+            if (roles[i].name() == name)
+                return static_cast<int>(i);
+        }
+        roles.emplace_back(name);
+        return static_cast<int>(roles.size()) - 1;
+    }
+
+    void parseConditional()
+    {
+        parseOr();
+        if (!accept("?"))
+            return;
+
+        const int jumpToElse = emit(Predicate::OpCode::JumpIfFalse);
+        --m_depth;
+        parseConditional();
+        expect(":");
+        const int jumpToEnd = emit(Predicate::OpCode::Jump);
+        patchJump(jumpToElse);
+        --m_depth; // The else branch starts from the same depth as the then branch
+        parseConditional();
+        patchJump(jumpToEnd);
+    }
+
+    void parseOr()
+    {
+        parseAnd();
+        while (accept("||")) {
+            const int jump = emit(Predicate::OpCode::JumpIfTrueOrPop);
+            --m_depth;
+            parseAnd();
+            patchJump(jump);
+        }
+    }
+
+    void parseAnd()
+    {
+        parseEquality();
+        while (accept("&&")) {
+            const int jump = emit(Predicate::OpCode::JumpIfFalseOrPop);
+            --m_depth;
+            parseEquality();
+            patchJump(jump);
+        }
+    }
+
+    void parseEquality()
+    {
+        parseRelational();
+        while (m_error.isEmpty()) {
+            if (accept("===") || accept("==")) {
+                parseRelational();
+                binary(Predicate::OpCode::Equal);
+            } else if (accept("!==") || accept("!=")) {
+                parseRelational();
+                binary(Predicate::OpCode::NotEqual);
+            } else {
+                return;
+            }
+        }
+    }
+
+    void parseRelational()
+    {
+        parseAdditive();
+        while (m_error.isEmpty()) {
+            Predicate::OpCode opCode;
+            if (accept("<="))
+                opCode = Predicate::OpCode::LessOrEqual;
+            else if (accept(">="))
+                opCode = Predicate::OpCode::GreaterOrEqual;
+            else if (accept("<"))
+                opCode = Predicate::OpCode::Less;
+            else if (accept(">"))
+                opCode = Predicate::OpCode::Greater;
+            else
+                return;
+            parseAdditive();
+            binary(opCode);
+        }
+    }
+
+    void parseAdditive()
+    {
+        parseMultiplicative();
+        while (m_error.isEmpty()) {
+            Predicate::OpCode opCode;
+            if (accept("+"))
+                opCode = Predicate::OpCode::Add;
+            else if (accept("-"))
+                opCode = Predicate::OpCode::Subtract;
+            else
+                return;
+            parseMultiplicative();
+            binary(opCode);
+        }
+    }
+
+    void parseMultiplicative()
+    {
+        parseUnary();
+        while (m_error.isEmpty()) {
+            Predicate::OpCode opCode;
+            if (accept("*"))
+                opCode = Predicate::OpCode::Multiply;
+            else if (accept("/"))
+                opCode = Predicate::OpCode::Divide;
+            else if (accept("%"))
+                opCode = Predicate::OpCode::Modulo;
+            else
+                return;
+            parseUnary();
+            binary(opCode);
+        }
+    }
+
+    void parseUnary()
+    {
+        if (accept("!")) {
+            parseUnary();
+            emit(Predicate::OpCode::Not);
+        } else if (accept("-")) {
+            parseUnary();
+            emit(Predicate::OpCode::Negate);
+        } else if (accept("+")) {
+            parseUnary();
+        } else {
+            parsePrimary();
+        }
+    }
+
+    void parsePrimary()
+    {
+        if (!m_error.isEmpty())
+            return;
+
+        const Token token = m_token;
+        switch (token.type) {
+            case TokenType::Number:
+                next();
+                pushConstant(Predicate::Value(token.number));
+                return;
+            case TokenType::String:
+                next();
+                pushConstant(Predicate::Value(token.text));
+                return;
+            case TokenType::Identifier:
+                next();
+                parseIdentifier(token.text);
+                return;
+            case TokenType::Operator:
+                if (accept("(")) {
+                    parseConditional();
+                    expect(")");
+                    return;
+                }
+                break;
+            case TokenType::End:
+                break;
+        }
+        fail(token.type == TokenType::End ? QStringLiteral("unexpected end of expression")
+                                          : QStringLiteral("unexpected '%1'").arg(token.text));
+    }
+
+    void parseIdentifier(const QString& identifier)
+    {
+        if (identifier == QLatin1String("true")) {
+            pushConstant(Predicate::Value(true));
+        } else if (identifier == QLatin1String("false")) {
+            pushConstant(Predicate::Value(false));
+        } else if (identifier == QLatin1String("null") || identifier == QLatin1String("undefined")) {
+            pushConstant(Predicate::Value());
+        } else if (identifier == QLatin1String("index")) {
+            push(Predicate::OpCode::LoadIndex);
+        } else if (identifier == QLatin1String("model") || identifier == QLatin1String("modelLeft") || identifier == QLatin1String("modelRight")) {
+            const Predicate::Side side = identifier == QLatin1String("modelRight") ? Predicate::Right : Predicate::Left;
+            expect(".");
+            if (m_token.type != TokenType::Identifier) {
+                fail(QStringLiteral("expected a role name"));
+                return;
+            }
+            const QString name = m_token.text;
+            next();
+            if (name == QLatin1String("index"))
+                push(Predicate::OpCode::LoadIndex, 0, side);
+            else
+                push(Predicate::OpCode::LoadRole, roleIndex(name), side);
+        } else {
+            push(Predicate::OpCode::LoadRole, roleIndex(identifier));
+        }
+    }
+
+    void pushConstant(const Predicate::Value& value)
+    {
+        m_predicate.m_constants.push_back(value);
+        push(Predicate::OpCode::PushConstant, static_cast<int>(m_predicate.m_constants.size()) - 1);
+    }
+
+    const QString& m_source;
+    Predicate& m_predicate;
+    Token m_token;
+    QString m_error;
+    int m_position = 0;
+    int m_depth = 0;
+    int m_maxDepth = 0;
+};
+
+}
+
+const QString& Predicate::source() const
+{
+    return m_source;
+}
+
+const QString& Predicate::errorString() const
+{
+    return m_errorString;
+}
+
+bool Predicate::isEmpty() const
+{
+    return m_code.empty();
+}
+
+bool Predicate::compile(const QString& source)
+{
+    m_source = source;
+    m_errorString.clear();
+    m_code.clear();
+    m_constants.clear();
+    m_roles.clear();
+    m_stackSize = 0;
+
+    if (source.trimmed().isEmpty())
+        return true;
+
+    if (!PredicateCompiler(source, *this).compile()) {
+        m_code.clear();
+        m_constants.clear();
+        m_roles.clear();
+        return false;
+    }
+    return true;
+}
+
+Predicate::Value Predicate::evaluate(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const
+{
+    return evaluate(sourceIndex, sourceIndex, proxyModel);
+}
+
+namespace {
+
+bool equals(const Predicate::Value& left, const Predicate::Value& right)
+{
+    if (left.type() != right.type())
+        return false;
+    if (left.type() == Predicate::Value::Type::String)
+        return left.string() == right.string();
+    return left.number() == right.number();
+}
+
+// Ordering of values of the same type, Unordered otherwise
+QPartialOrdering order(const Predicate::Value& left, const Predicate::Value& right)
+{
+    if (left.type() != right.type())
+        return QPartialOrdering::Unordered;
+    if (left.type() == Predicate::Value::Type::String) {
+        const int comparison = left.string().compare(right.string());
+        return comparison < 0 ? QPartialOrdering::Less : comparison > 0 ? QPartialOrdering::Greater : QPartialOrdering::Equivalent;
+    }
+    if (left.number() < right.number())
+        return QPartialOrdering::Less;
+    if (left.number() > right.number())
+        return QPartialOrdering::Greater;
+    return left.number() == right.number() ? QPartialOrdering::Equivalent : QPartialOrdering::Unordered;
+}
+
+Predicate::Value arithmetic(char op, const Predicate::Value& left, const Predicate::Value& right)
+{
+    if (op == '+' && (left.type() == Predicate::Value::Type::String || right.type() == Predicate::Value::Type::String))
+        return Predicate::Value(left.toString() + right.toString());
+    if (left.type() != Predicate::Value::Type::Number || right.type() != Predicate::Value::Type::Number)
+        return Predicate::Value();
+
+    switch (op) {
+        case '+': return Predicate::Value(left.number() + right.number());
+        case '-': return Predicate::Value(left.number() - right.number());
+        case '*': return Predicate::Value(left.number() * right.number());
+        case '/': return Predicate::Value(left.number() / right.number());
+        default: return Predicate::Value(std::fmod(left.number(), right.number()));
+    }
+}
+
+}
+
+Predicate::Value Predicate::evaluate(const QModelIndex& sourceLeft, const QModelIndex& sourceRight, const QQmlSortFilterProxyModel& proxyModel) const
+{
+    if (m_code.empty())
+        return Value();
+
+    QVarLengthArray<Value, 16> stack;
+    stack.reserve(m_stackSize);
+
+    const int size = static_cast<int>(m_code.size());
+    for (int pc = 0; pc < size; ++pc) {
+        const Instruction& instruction = m_code[pc];
+        switch (instruction.opCode) {
+            case OpCode::PushConstant:
+                stack.append(m_constants[instruction.operand]);
+                break;
+            case OpCode::LoadRole: {
+                const QModelIndex& sourceIndex = instruction.side == Left ? sourceLeft : sourceRight;
+                const int role = m_roles[instruction.operand].role(proxyModel);
+                stack.append(role < 0 ? Value() : Value::fromVariant(proxyModel.sourceData(sourceIndex, role)));
+                break;
+            }
+            case OpCode::LoadIndex:
+                stack.append(Value(static_cast<double>((instruction.side == Left ? sourceLeft : sourceRight).row())));
+                break;
+            case OpCode::Not:
+                stack.last() = Value(!stack.last().isTruthy());
+                break;
+            case OpCode::Negate:
+                stack.last() = stack.last().type() == Value::Type::Number ? Value(-stack.last().number()) : Value();
+                break;
+            case OpCode::Jump:
+                pc = instruction.operand - 1;
+                break;
+            case OpCode::JumpIfFalse: {
+                const bool condition = stack.last().isTruthy();
+                stack.removeLast();
+                if (!condition)
+                    pc = instruction.operand - 1;
+                break;
+            }
+            case OpCode::JumpIfFalseOrPop:
+                if (!stack.last().isTruthy())
+                    pc = instruction.operand - 1;
+                else
+                    stack.removeLast();
+                break;
+            case OpCode::JumpIfTrueOrPop:
+                if (stack.last().isTruthy())
+                    pc = instruction.operand - 1;
+                else
+                    stack.removeLast();
+                break;
+            default: {
+                // Binary operators
+                const Value right = stack.takeLast();
+                Value& left = stack.last();
+                switch (instruction.opCode) {
+                    case OpCode::Add: left = arithmetic('+', left, right); break;
+                    case OpCode::Subtract: left = arithmetic('-', left, right); break;
+                    case OpCode::Multiply: left = arithmetic('*', left, right); break;
+                    case OpCode::Divide: left = arithmetic('/', left, right); break;
+                    case OpCode::Modulo: left = arithmetic('%', left, right); break;
+                    case OpCode::Equal: left = Value(equals(left, right)); break;
+                    case OpCode::NotEqual: left = Value(!equals(left, right)); break;
+                    case OpCode::Less: left = Value(order(left, right) == QPartialOrdering::Less); break;
+                    case OpCode::LessOrEqual: {
+                        const QPartialOrdering ordering = order(left, right);
+                        left = Value(ordering == QPartialOrdering::Less || ordering == QPartialOrdering::Equivalent);
+                        break;
+                    }
+                    case OpCode::Greater: left = Value(order(left, right) == QPartialOrdering::Greater); break;
+                    case OpCode::GreaterOrEqual: {
+                        const QPartialOrdering ordering = order(left, right);
+                        left = Value(ordering == QPartialOrdering::Greater || ordering == QPartialOrdering::Equivalent);
+                        break;
+                    }
+                    default: break;
+                }
+                break;
+            }
+        }
+    }
+    return stack.isEmpty() ? Value() : stack.last();
+}
+
+void Predicate::appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const
+{
+    for (const CachedRole& role : m_roles)
+        roles.append(role.role(proxyModel));
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "cachedrole.h"
+#include <QModelIndex>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <vector>
+
+namespace JApp::Models {
+
+class QQmlSortFilterProxyModel;
+
+// A small expression language over role values, evaluated natively instead of by the JS engine.
+// Expressions are compiled once into a flat stack bytecode. Supported syntax:
+//   literals       42, 1.5, "text", 'text', true, false, null
+//   row data       model.role, role, index, model.index, modelLeft.role, modelRight.role
+//   operators      ?: || && == != === !== < <= > >= + - * / % ! and unary -
+// Values are null, booleans, numbers or strings, without implicit conversions between them:
+// 1 == "1" and true == 1 are false, and comparing values of different types is always false.
+class Predicate
+{
+public:
+    class Value
+    {
+    public:
+        enum class Type {
+            Null,
+            Bool,
+            Number,
+            String
+        };
+
+        Value() = default;
+        explicit Value(bool value);
+        explicit Value(double value);
+        explicit Value(const QString& value);
+
+        static Value fromVariant(const QVariant& variant);
+        QVariant toVariant() const;
+
+        Type type() const;
+        bool isTruthy() const;
+        double number() const;
+        const QString& string() const;
+        QString toString() const;
+
+    private:
+        Type m_type = Type::Null;
+        double m_number = 0;
+        QString m_string;
+    };
+
+    const QString& source() const;
+    const QString& errorString() const;
+    bool isEmpty() const;
+
+    // Returns false and keeps the predicate empty when the source doesn't parse.
+    bool compile(const QString& source);
+
+    // model, index and modelLeft refer to the left row, modelRight to the right row.
+    Value evaluate(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const;
+    Value evaluate(const QModelIndex& sourceLeft, const QModelIndex& sourceRight, const QQmlSortFilterProxyModel& proxyModel) const;
+
+    void appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const;
+
+private:
+    friend class PredicateCompiler;
+
+    enum class OpCode : quint8 {
+        PushConstant,
+        LoadRole,
+        LoadIndex,
+        Not,
+        Negate,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Modulo,
+        Equal,
+        NotEqual,
+        Less,
+        LessOrEqual,
+        Greater,
+        GreaterOrEqual,
+        Jump,
+        JumpIfFalse,        // Pops the condition
+        JumpIfFalseOrPop,   // Keeps the value when jumping, for &&
+        JumpIfTrueOrPop     // Keeps the value when jumping, for ||
+    };
+
+    enum Side : quint8 {
+        Left,
+        Right
+    };
+
+    struct Instruction {
+        OpCode opCode;
+        Side side;
+        int operand; // Constant, role or jump target, depending on the op code
+    };
+
+    QString m_source;
+    QString m_errorString;
+    std::vector<Instruction> m_code;
+    std::vector<Value> m_constants;
+    std::vector<CachedRole> m_roles;
+    int m_stackSize = 0;
+};
+
+}
@@ -41,6 +41,10 @@ void JoinRole::setRoleNames(const QStringList& roleNames)
         return;
 
     m_roleNames = roleNames;
+    m_roles.clear();
+    m_roles.reserve(roleNames.size());
+    for (const QString& roleName : roleNames)
+        m_roles.append(CachedRole(roleName));
     Q_EMIT roleNamesChanged();
     invalidate();
 }
@@ -71,8 +75,8 @@ QVariant JoinRole::data(const QModelIndex &sourceIndex, const QQmlSortFilterProx
 {
     QString result;
 
-    for (const QString& roleName : m_roleNames)
-        result += proxyModel.sourceData(sourceIndex, roleName).toString() + m_separator;
+    for (const CachedRole& role : std::as_const(m_roles))
+        result += proxyModel.sourceData(sourceIndex, role.role(proxyModel)).toString() + m_separator;
 
     if (!m_roleNames.isEmpty())
         result.chop(m_separator.length());
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "singlerole.h"
+#include "cachedrole.h"
+#include <QVector>
 
 namespace JApp::Models {
 
@@ -26,6 +28,7 @@ Q_SIGNALS:
 
 private:
     QStringList m_roleNames;
+    QVector<CachedRole> m_roles;
     QVariant data(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) override;
     QString m_separator = " ";
 };
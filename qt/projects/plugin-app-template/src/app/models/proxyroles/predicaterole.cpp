@@ -0,0 +1,55 @@
+#include "predicaterole.h"
+#include "qqmlsortfilterproxymodel.h"
+#include <JApp/Log.h>
+
+using namespace JApp::Models;
+
+/*!
+    \qmltype PredicateRole
+    \inherits SingleRole
+    \inqmlmodule SortFilterProxyModel
+    \ingroup ProxyRoles
+    \brief A custom role computed from a native predicate expression.
+
+    A PredicateRole is a \l ProxyRole computed from an expression, like \l ExpressionRole,
+    but compiled once by the model and evaluated without the javascript engine.
+
+    In the following example, the \c c role is computed by adding the \c a role and \c b role of the model :
+    \code
+    SortFilterProxyModel {
+       sourceModel: numberModel
+       proxyRoles: PredicateRole {
+           name: "c"
+           expression: "model.a + model.b"
+      }
+    }
+    \endcode
+*/
+
+/*!
+    \qmlproperty string PredicateRole::expression
+
+    The expression computing the role. Its syntax is the one of \l {PredicateFilter::expression} {PredicateFilter}.
+    The data of the role is a number, a string, a bool, or undefined for \c null and when the expression is empty or doesn't parse.
+*/
+const QString& PredicateRole::expression() const
+{
+    return m_predicate.source();
+}
+
+void PredicateRole::setExpression(const QString& expression)
+{
+    if (m_predicate.source() == expression)
+        return;
+
+    if (!m_predicate.compile(expression))
+        LOG_WARN() << "Failed to parse predicate" << expression << ":" << m_predicate.errorString();
+
+    Q_EMIT expressionChanged();
+    invalidate();
+}
+
+QVariant PredicateRole::data(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel)
+{
+    return m_predicate.evaluate(sourceIndex, proxyModel).toVariant();
+}
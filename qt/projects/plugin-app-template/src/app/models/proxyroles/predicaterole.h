@@ -0,0 +1,28 @@
+#pragma once
+
+#include "singlerole.h"
+#include "predicate.h"
+
+namespace JApp::Models {
+
+class PredicateRole : public SingleRole
+{
+    Q_OBJECT
+    Q_PROPERTY(QString expression READ expression WRITE setExpression NOTIFY expressionChanged)
+
+public:
+    using SingleRole::SingleRole;
+
+    const QString& expression() const;
+    void setExpression(const QString& expression);
+
+Q_SIGNALS:
+    void expressionChanged();
+
+private:
+    QVariant data(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) override;
+
+    Predicate m_predicate;
+};
+
+}
@@ -2,6 +2,7 @@
 #include "joinrole.h"
 #include "switchrole.h"
 #include "expressionrole.h"
+#include "predicaterole.h"
 #include "regexprole.h"
 #include "filterrole.h"
 #include <QQmlEngine>
@@ -14,6 +15,7 @@ void registerProxyRoleTypes() {
     qmlRegisterType<JoinRole>("SortFilterProxyModel", 0, 2, "JoinRole");
     qmlRegisterType<SwitchRole>("SortFilterProxyModel", 0, 2, "SwitchRole");
     qmlRegisterType<ExpressionRole>("SortFilterProxyModel", 0, 2, "ExpressionRole");
+    qmlRegisterType<PredicateRole>("SortFilterProxyModel", 0, 2, "PredicateRole");
     qmlRegisterType<RegExpRole>("SortFilterProxyModel", 0, 2, "RegExpRole");
     qmlRegisterType<FilterRole>("SortFilterProxyModel", 0, 2, "FilterRole");
 }
@@ -32,15 +32,15 @@ using namespace JApp::Models;
 */
 QString RegExpRole::roleName() const
 {
-    return m_roleName;
+    return m_role.name();
 }
 
 void RegExpRole::setRoleName(const QString& roleName)
 {
-    if (m_roleName == roleName)
+    if (m_role.name() == roleName)
         return;
 
-    m_roleName = roleName;
+    m_role.setName(roleName);
     Q_EMIT roleNameChanged();
 }
 
@@ -96,7 +96,7 @@ QStringList RegExpRole::names()
 
 QVariant RegExpRole::data(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel, const QString &name)
 {
-    QString text = proxyModel.sourceData(sourceIndex, m_roleName).toString();
+    QString text = proxyModel.sourceData(sourceIndex, m_role.role(proxyModel)).toString();
     QRegularExpressionMatch match = m_regularExpression.match(text);
     return match.hasMatch() ? (match.captured(name)) : QVariant{};
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "proxyrole.h"
+#include "cachedrole.h"
 #include <QRegularExpression>
 
 namespace JApp::Models {
@@ -32,7 +33,7 @@ Q_SIGNALS:
     void caseSensitivityChanged();
 
 private:
-    QString m_roleName;
+    CachedRole m_role;
     QRegularExpression m_regularExpression;
     QVariant data(const QModelIndex &sourceIndex, const QQmlSortFilterProxyModel &proxyModel, const QString &name) override;
 };
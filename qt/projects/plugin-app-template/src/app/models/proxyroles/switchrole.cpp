@@ -67,15 +67,15 @@ void SwitchRoleAttached::setValue(QVariant value)
 */
 QString SwitchRole::defaultRoleName() const
 {
-    return m_defaultRoleName;
+    return m_defaultRole.name();
 }
 
 void SwitchRole::setDefaultRoleName(const QString& defaultRoleName)
 {
-    if (m_defaultRoleName == defaultRoleName)
+    if (m_defaultRole.name() == defaultRoleName)
         return;
 
-    m_defaultRoleName = defaultRoleName;
+    m_defaultRole.setName(defaultRoleName);
     Q_EMIT defaultRoleNameChanged();
     invalidate();
 }
@@ -141,8 +141,8 @@ QVariant SwitchRole::data(const QModelIndex &sourceIndex, const QQmlSortFilterPr
             return value;
         }
     }
-    if (!m_defaultRoleName.isEmpty())
-        return proxyModel.sourceData(sourceIndex, m_defaultRoleName);
+    if (!m_defaultRole.name().isEmpty())
+        return proxyModel.sourceData(sourceIndex, m_defaultRole.role(proxyModel));
     return m_defaultValue;
 }
 
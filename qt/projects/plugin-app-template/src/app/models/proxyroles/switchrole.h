@@ -2,6 +2,7 @@
 
 #include "singlerole.h"
 #include "filters/filtercontainer.h"
+#include "cachedrole.h"
 #include <QtQml>
 
 namespace JApp::Models {
@@ -56,7 +57,7 @@ private:
     void onFilterRemoved(Filter *filter) override;
     void onFiltersCleared() override;
 
-    QString m_defaultRoleName;
+    CachedRole m_defaultRole;
     QVariant m_defaultValue;
 };
 
@@ -1,13 +1,23 @@
 #include "qqmlsortfilterproxymodel.h"
 #include <QtQml>
+#include <QtConcurrent>
 #include <algorithm>
+#include <utility>
 #include "filters/filter.h"
 #include "sorters/sorter.h"
 #include "proxyroles/proxyrole.h"
 #include <JApp/Log.h>
+#include <JApp/Trace.h>
 
 using namespace JApp::Models;
 
+namespace {
+
+// Rows per parallel filtering task, and the fewest rows worth filtering in parallel
+constexpr int ParallelFilteringChunkSize = 4096;
+
+}
+
 /*!
     \qmltype SortFilterProxyModel
     \inqmlmodule SortFilterProxyModel
@@ -76,6 +86,59 @@ void QQmlSortFilterProxyModel::setDelayed(bool delayed)
     Q_EMIT delayedChanged();
 }
 
+/*!
+    \qmlproperty bool SortFilterProxyModel::cacheRoles
+
+    Keep the source roles used by the filters and sorters in a cache of typed arrays.
+    Each role is read once for all rows when filters or sorters are invalidated, then kept up to date
+    as the source model changes, so filtering and sorting don't go through the source model's \c data().
+    Only top level rows are cached. This trades memory for speed on large models.
+
+    By default, roles are not cached.
+*/
+bool QQmlSortFilterProxyModel::cacheRoles() const
+{
+    return m_cacheRoles;
+}
+
+void QQmlSortFilterProxyModel::setCacheRoles(bool cacheRoles)
+{
+    if (m_cacheRoles == cacheRoles)
+        return;
+
+    m_cacheRoles = cacheRoles;
+    m_roleCache.invalidate();
+    Q_EMIT cacheRolesChanged();
+}
+
+/*!
+    \qmlproperty bool SortFilterProxyModel::parallelFiltering
+
+    Evaluate the filters of all top level rows on a pool of threads when the filters are invalidated,
+    instead of one row at a time on the model's thread. The roles used by the filters are read from the
+    same cache as with \l cacheRoles, which is built first and kept while this property is set.
+
+    Only the native filters that read roles run in parallel: RoleFilter based filters, PredicateFilter, and
+    AllOf and AnyOf containing those. An enabled ExpressionFilter or IndexFilter, or a filter on a proxy role,
+    makes all filters run sequentially. Models with fewer than a few thousand rows are always filtered sequentially.
+
+    By default, filters are evaluated sequentially.
+*/
+bool QQmlSortFilterProxyModel::parallelFiltering() const
+{
+    return m_parallelFiltering;
+}
+
+void QQmlSortFilterProxyModel::setParallelFiltering(bool parallelFiltering)
+{
+    if (m_parallelFiltering == parallelFiltering)
+        return;
+
+    m_parallelFiltering = parallelFiltering;
+    m_roleCache.invalidate();
+    Q_EMIT parallelFilteringChanged();
+}
+
 const QString& QQmlSortFilterProxyModel::filterRoleName() const
 {
     return m_filterRoleName;
@@ -242,6 +305,11 @@ QVariant QQmlSortFilterProxyModel::sourceData(const QModelIndex &sourceIndex) co
     return map;
 }
 
+bool QQmlSortFilterProxyModel::hasSourceGetMethod() const
+{
+    return m_sourceGetMethod.isValid();
+}
+
 QVariant QQmlSortFilterProxyModel::sourceData(const QModelIndex& sourceIndex, const QString& roleName) const
 {
     int role = roleNames().key(roleName.toUtf8());
@@ -250,11 +318,14 @@ QVariant QQmlSortFilterProxyModel::sourceData(const QModelIndex& sourceIndex, co
 
 QVariant QQmlSortFilterProxyModel::sourceData(const QModelIndex &sourceIndex, int role) const
 {
-    QPair<ProxyRole*, QString> proxyRolePair = m_proxyRoleMap[role];
-    if (ProxyRole* proxyRole = proxyRolePair.first)
-        return proxyRole->roleData(sourceIndex, *this, proxyRolePair.second);
-    else
-        return sourceModel()->data(sourceIndex, role);
+    if (isProxyRole(role)) {
+        const auto it = m_proxyRoleMap.constFind(role);
+        if (it != m_proxyRoleMap.cend())
+            return it->first->roleData(sourceIndex, *this, it->second);
+    }
+    if (const RoleColumnCache::Column* column = cachedRoleColumn(sourceIndex, role))
+        return column->value(sourceIndex.row());
+    return sourceModel()->data(sourceIndex, role);
 }
 
 QVariant QQmlSortFilterProxyModel::data(const QModelIndex &index, int role) const
@@ -279,6 +350,27 @@ int QQmlSortFilterProxyModel::roleForName(const QString& roleName) const
     return m_roleNames.key(roleName.toUtf8(), -1);
 }
 
+int QQmlSortFilterProxyModel::rolesRevision() const
+{
+    return m_rolesRevision;
+}
+
+bool QQmlSortFilterProxyModel::isProxyRole(int role) const
+{
+    // Proxy roles are numbered after every source role
+    return !m_proxyRoleNumbers.isEmpty() && role >= m_proxyRoleNumbers.first();
+}
+
+const RoleColumnCache::Column* QQmlSortFilterProxyModel::cachedRoleColumn(const QModelIndex& sourceIndex, int role) const
+{
+    // The cache holds the top level rows of column 0
+    if (!(m_cacheRoles || m_parallelFiltering) || role < 0 || !sourceModel() || sourceIndex.column() != 0 || sourceIndex.parent().isValid())
+        return nullptr;
+    if (!m_roleCache.isValid())
+        m_roleCache.build(*sourceModel(), usedRoles());
+    return m_roleCache.column(role);
+}
+
 /*!
     \qmlmethod object SortFilterProxyModel::get(int row)
 
@@ -358,15 +450,16 @@ bool QQmlSortFilterProxyModel::filterAcceptsRow(int source_row, const QModelInde
 {
     if (!m_completed)
         return true;
+
+    if (isRowUnaffectedByFilterChange(source_row, source_parent))
+        return m_acceptedSourceRows.testBit(source_row);
+
     QModelIndex sourceIndex = sourceModel()->index(source_row, 0, source_parent);
     bool valueAccepted = !m_filterValue.isValid() || ( m_filterValue == sourceModel()->data(sourceIndex, filterRole()) );
     bool baseAcceptsRow = valueAccepted && QSortFilterProxyModel::filterAcceptsRow(source_row, source_parent);
-    baseAcceptsRow = baseAcceptsRow && std::all_of(m_filters.begin(), m_filters.end(),
-        [=] (Filter* filter) {
-            return filter->filterAcceptsRow(sourceIndex, *this);
-        }
-    );
-    return baseAcceptsRow;
+    if (!source_parent.isValid() && static_cast<size_t>(source_row) < m_parallelAcceptedRows.size())
+        return baseAcceptsRow && m_parallelAcceptedRows[source_row];
+    return baseAcceptsRow && filtersAcceptRow(sourceIndex);
 }
 
 bool QQmlSortFilterProxyModel::lessThan(const QModelIndex& source_left, const QModelIndex& source_right) const
@@ -378,13 +471,7 @@ bool QQmlSortFilterProxyModel::lessThan(const QModelIndex& source_left, const QM
             if (QSortFilterProxyModel::lessThan(source_right, source_left))
                 return !m_ascendingSortOrder;
         }
-        auto sortedSorters = m_sorters;
-        std::stable_sort(sortedSorters.begin(),
-                         sortedSorters.end(),
-                         [] (Sorter* a, Sorter* b) {
-                             return a->priority() > b->priority();
-                         });
-        for(auto sorter : sortedSorters) {
+        for(auto sorter : m_sortedSorters) {
             if (sorter->enabled()) {
                 int comparison = sorter->compareRows(source_left, source_right, *this);
                 if (comparison != 0)
@@ -407,7 +494,25 @@ void QQmlSortFilterProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
         // QTBUG-57971
         connect(sourceModel, &QAbstractItemModel::rowsInserted, this, &QQmlSortFilterProxyModel::initRoles);
     }
+    if (QAbstractItemModel* previousModel = this->sourceModel()) {
+        disconnect(previousModel, &QAbstractItemModel::dataChanged, this, &QQmlSortFilterProxyModel::onSourceDataChanged);
+        disconnect(previousModel, &QAbstractItemModel::rowsInserted, this, &QQmlSortFilterProxyModel::onSourceRowsInserted);
+        disconnect(previousModel, &QAbstractItemModel::rowsRemoved, this, &QQmlSortFilterProxyModel::onSourceRowsRemoved);
+        disconnect(previousModel, &QAbstractItemModel::rowsMoved, this, &QQmlSortFilterProxyModel::resetRowCaches);
+        disconnect(previousModel, &QAbstractItemModel::layoutChanged, this, &QQmlSortFilterProxyModel::resetRowCaches);
+        disconnect(previousModel, &QAbstractItemModel::modelReset, this, &QQmlSortFilterProxyModel::resetRowCaches);
+    }
+    resetRowCaches();
     if (sourceModel) {
+        // Connected before QSortFilterProxyModel's own handlers, so the role cache is up to date
+        // when they filter and sort the changed rows
+        connect(sourceModel, &QAbstractItemModel::dataChanged, this, &QQmlSortFilterProxyModel::onSourceDataChanged);
+        connect(sourceModel, &QAbstractItemModel::rowsInserted, this, &QQmlSortFilterProxyModel::onSourceRowsInserted);
+        connect(sourceModel, &QAbstractItemModel::rowsRemoved, this, &QQmlSortFilterProxyModel::onSourceRowsRemoved);
+        connect(sourceModel, &QAbstractItemModel::rowsMoved, this, &QQmlSortFilterProxyModel::resetRowCaches);
+        connect(sourceModel, &QAbstractItemModel::layoutChanged, this, &QQmlSortFilterProxyModel::resetRowCaches);
+        connect(sourceModel, &QAbstractItemModel::modelReset, this, &QQmlSortFilterProxyModel::resetRowCaches);
+
         m_sourceGetMethod = sourceModel->metaObject()->method(sourceModel->metaObject()->indexOfMethod("get(QModelIndex)"));
         if (!m_sourceGetMethod.isValid()) {
             m_sourceGetMethod = sourceModel->metaObject()->method(sourceModel->metaObject()->indexOfMethod("get(int)"));
@@ -420,6 +525,13 @@ void QQmlSortFilterProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
 
 void QQmlSortFilterProxyModel::queueInvalidateFilter()
 {
+    queueFilterChange(Filter::Change::Any);
+}
+
+void QQmlSortFilterProxyModel::queueFilterChange(Filter::Change change)
+{
+    // Changes queued together only narrow or widen the accepted rows if they all do
+    m_filterChange = m_invalidateFilterQueued && m_filterChange != change ? Filter::Change::Any : change;
     if (m_delayed) {
         if (!m_invalidateFilterQueued && !m_invalidateQueued) {
             m_invalidateFilterQueued = true;
@@ -432,9 +544,29 @@ void QQmlSortFilterProxyModel::queueInvalidateFilter()
 
 void QQmlSortFilterProxyModel::invalidateFilter()
 {
+    TRACE_SCOPE("invalidateFilter");
     m_invalidateFilterQueued = false;
-    if (m_completed && !m_invalidateQueued)
-        QSortFilterProxyModel::invalidateFilter();
+    const Filter::Change change = std::exchange(m_filterChange, Filter::Change::Any);
+    // Narrowing and widening changes don't make filters read other roles, except for enabled
+    // filters whose roles are then read from the source model until the next full invalidation
+    if (change == Filter::Change::Any)
+        m_roleCache.invalidate();
+    if (!m_completed || m_invalidateQueued)
+        return;
+
+    if (change != Filter::Change::Any && sourceModel()) {
+        m_acceptedSourceRows = QBitArray(sourceModel()->rowCount());
+        const int proxyRowCount = rowCount();
+        for (int row = 0; row < proxyRowCount; ++row)
+            m_acceptedSourceRows.setBit(mapToSource(index(row, 0)).row());
+        m_appliedFilterChange = change;
+    }
+    filterInParallel();
+    QSortFilterProxyModel::invalidateFilter();
+    buildRootMapping();
+    m_appliedFilterChange = Filter::Change::Any;
+    m_acceptedSourceRows.clear();
+    m_parallelAcceptedRows.clear();
 }
 
 void QQmlSortFilterProxyModel::queueInvalidate()
@@ -451,13 +583,22 @@ void QQmlSortFilterProxyModel::queueInvalidate()
 
 void QQmlSortFilterProxyModel::invalidate()
 {
+    TRACE_SCOPE("invalidate");
     m_invalidateQueued = false;
-    if (m_completed)
-        QSortFilterProxyModel::invalidate();
+    m_roleCache.invalidate();
+    if (!m_completed)
+        return;
+
+    filterInParallel();
+    QSortFilterProxyModel::invalidate();
+    buildRootMapping();
+    m_parallelAcceptedRows.clear();
 }
 
 void QQmlSortFilterProxyModel::updateRoleNames()
 {
+    ++m_rolesRevision;
+    resetRowCaches();
     if (!sourceModel())
         return;
     m_roleNames = sourceModel()->roleNames();
@@ -519,6 +660,9 @@ void QQmlSortFilterProxyModel::onDataChanged(const QModelIndex& topLeft, const Q
 
 void QQmlSortFilterProxyModel::queueInvalidateProxyRoles()
 {
+    // Sorters may keep per row data computed from proxy roles, e.g. ExpressionSorter keys
+    for (Sorter* sorter : std::as_const(m_sorters))
+        sorter->sourceRowsReset();
     queueInvalidate();
     if (m_delayed) {
         if (!m_invalidateProxyRolesQueued) {
@@ -532,11 +676,164 @@ void QQmlSortFilterProxyModel::queueInvalidateProxyRoles()
 
 void QQmlSortFilterProxyModel::invalidateProxyRoles()
 {
+    TRACE_SCOPE("invalidateProxyRoles");
     m_invalidateProxyRolesQueued = false;
     if (m_completed)
         Q_EMIT dataChanged(index(0,0), index(rowCount() - 1, columnCount() - 1), m_proxyRoleNumbers);
 }
 
+void QQmlSortFilterProxyModel::updateSortedSorters()
+{
+    m_sortedSorters = m_sorters;
+    std::stable_sort(m_sortedSorters.begin(),
+                     m_sortedSorters.end(),
+                     [] (Sorter* a, Sorter* b) {
+                         return a->priority() > b->priority();
+                     });
+}
+
+void QQmlSortFilterProxyModel::resetRowCaches()
+{
+    m_roleCache.invalidate();
+    for (Sorter* sorter : m_sorters)
+        sorter->sourceRowsReset();
+}
+
+void QQmlSortFilterProxyModel::onSourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles)
+{
+    if (topLeft.parent().isValid() || topLeft.column() != 0)
+        return;
+
+    if (m_roleCache.isValid())
+        m_roleCache.updateRows(*sourceModel(), topLeft.row(), bottomRight.row(), roles);
+    for (Sorter* sorter : m_sorters)
+        sorter->sourceRowsChanged(topLeft.row(), bottomRight.row(), roles, *this);
+}
+
+void QQmlSortFilterProxyModel::onSourceRowsInserted(const QModelIndex& parent, int first, int last)
+{
+    if (parent.isValid())
+        return;
+
+    if (m_roleCache.isValid())
+        m_roleCache.insertRows(*sourceModel(), first, last);
+    for (Sorter* sorter : m_sorters)
+        sorter->sourceRowsInserted(first, last, *this);
+}
+
+void QQmlSortFilterProxyModel::onSourceRowsRemoved(const QModelIndex& parent, int first, int last)
+{
+    if (parent.isValid())
+        return;
+
+    if (m_roleCache.isValid())
+        m_roleCache.removeRows(first, last);
+    for (Sorter* sorter : m_sorters)
+        sorter->sourceRowsRemoved(first, last);
+}
+
+QVector<int> QQmlSortFilterProxyModel::usedRoles() const
+{
+    QVector<int> roles;
+    for (Filter* filter : m_filters) {
+        if (filter->enabled())
+            filter->appendUsedRoles(*this, roles);
+    }
+    for (Sorter* sorter : m_sorters) {
+        if (sorter->enabled())
+            sorter->appendUsedRoles(*this, roles);
+    }
+
+    // Source roles only, proxy roles are computed
+    roles.erase(std::remove_if(roles.begin(), roles.end(), [this] (int role) {
+                    return role < 0 || isProxyRole(role);
+                }), roles.end());
+    std::sort(roles.begin(), roles.end());
+    roles.erase(std::unique(roles.begin(), roles.end()), roles.end());
+    return roles;
+}
+
+bool QQmlSortFilterProxyModel::filtersAcceptRow(const QModelIndex& sourceIndex) const
+{
+    return std::all_of(m_filters.begin(), m_filters.end(),
+        [&] (Filter* filter) {
+            return filter->filterAcceptsRow(sourceIndex, *this);
+        }
+    );
+}
+
+bool QQmlSortFilterProxyModel::isRowUnaffectedByFilterChange(int sourceRow, const QModelIndex& sourceParent) const
+{
+    // Only rejected rows can be accepted by a widening change, and the other way around
+    return m_appliedFilterChange != Filter::Change::Any && !sourceParent.isValid() && sourceRow < m_acceptedSourceRows.size()
+        && m_acceptedSourceRows.testBit(sourceRow) == (m_appliedFilterChange == Filter::Change::Widening);
+}
+
+bool QQmlSortFilterProxyModel::canFilterInParallel() const
+{
+    if (!m_parallelFiltering || !sourceModel() || sourceModel()->rowCount() < ParallelFilteringChunkSize)
+        return false;
+
+    bool hasFilters = false;
+    QVector<int> roles;
+    for (Filter* filter : m_filters) {
+        if (!filter->enabled())
+            continue;
+        if (!filter->isThreadSafe())
+            return false;
+        // Also resolves the role numbers of the filter on this thread
+        filter->appendUsedRoles(*this, roles);
+        hasFilters = true;
+    }
+
+    // Proxy roles are computed on demand and unknown roles read from the source model, neither can be cached
+    return hasFilters && std::all_of(roles.begin(), roles.end(), [this] (int role) {
+        return role >= 0 && !isProxyRole(role);
+    });
+}
+
+void QQmlSortFilterProxyModel::filterInParallel()
+{
+    m_parallelAcceptedRows.clear();
+    if (!canFilterInParallel())
+        return;
+
+    TRACE_SCOPE("filterInParallel");
+    // The threads read roles from the cache only, which may miss the roles of a filter enabled since it was built
+    const QVector<int> roles = usedRoles();
+    if (!m_roleCache.isValid() || std::any_of(roles.begin(), roles.end(), [this] (int role) { return !m_roleCache.column(role); }))
+        m_roleCache.build(*sourceModel(), roles);
+
+    // The source model is only called from its own thread, the workers get its indexes
+    const int rowCount = sourceModel()->rowCount();
+    QVector<QModelIndex> indexes;
+    indexes.reserve(rowCount);
+    for (int row = 0; row < rowCount; ++row)
+        indexes.append(sourceModel()->index(row, 0));
+    QVector<int> chunks;
+    for (int first = 0; first < rowCount; first += ParallelFilteringChunkSize)
+        chunks.append(first);
+
+    // m_parallelAcceptedRows stays empty meanwhile, so filtersAcceptRow() evaluates the filters
+    std::vector<quint8> acceptedRows(rowCount);
+    QtConcurrent::blockingMap(chunks, [&] (int first) {
+        const int last = std::min(first + ParallelFilteringChunkSize, rowCount);
+        for (int row = first; row < last; ++row) {
+            if (!isRowUnaffectedByFilterChange(row, QModelIndex()))
+                acceptedRows[row] = filtersAcceptRow(indexes.at(row));
+        }
+    });
+    m_parallelAcceptedRows = std::move(acceptedRows);
+}
+
+void QQmlSortFilterProxyModel::buildRootMapping()
+{
+    // QSortFilterProxyModel rebuilds mappings lazily: without this, the first access after
+    // m_parallelAcceptedRows is cleared would filter every row again on the calling thread
+    if (!m_parallelAcceptedRows.empty())
+        rowCount();
+}
+
 QVariantMap QQmlSortFilterProxyModel::modelDataMap(const QModelIndex& modelIndex) const
 {
     QVariantMap map;
@@ -548,7 +845,7 @@ QVariantMap QQmlSortFilterProxyModel::modelDataMap(const QModelIndex& modelIndex
 
 void QQmlSortFilterProxyModel::onFilterAppended(Filter* filter)
 {
-    connect(filter, &Filter::invalidated, this, &QQmlSortFilterProxyModel::queueInvalidateFilter);
+    connect(filter, &Filter::invalidated, this, &QQmlSortFilterProxyModel::queueFilterChange);
     queueInvalidateFilter();
 }
 
@@ -566,17 +863,22 @@ void QQmlSortFilterProxyModel::onFiltersCleared()
 void QQmlSortFilterProxyModel::onSorterAppended(Sorter* sorter)
 {
     connect(sorter, &Sorter::invalidated, this, &QQmlSortFilterProxyModel::queueInvalidate);
+    connect(sorter, &Sorter::priorityChanged, this, &QQmlSortFilterProxyModel::updateSortedSorters);
+    sorter->sourceRowsReset();
+    updateSortedSorters();
     queueInvalidate();
 }
 
 void QQmlSortFilterProxyModel::onSorterRemoved(Sorter* sorter)
 {
-    Q_UNUSED(sorter)
+    disconnect(sorter, &Sorter::priorityChanged, this, &QQmlSortFilterProxyModel::updateSortedSorters);
+    updateSortedSorters();
     queueInvalidate();
 }
 
 void QQmlSortFilterProxyModel::onSortersCleared()
 {
+    updateSortedSorters();
     queueInvalidate();
 }
 
@@ -12,9 +12,13 @@
 
 #include <QSortFilterProxyModel>
 #include <QQmlParserStatus>
+#include <QBitArray>
+#include "filters/filter.h"
 #include "filters/filtercontainer.h"
 #include "sorters/sortercontainer.h"
 #include "proxyroles/proxyrolecontainer.h"
+#include "rolecolumncache.h"
+#include <vector>
 
 namespace JApp::Models {
 
@@ -32,6 +36,8 @@ class QQmlSortFilterProxyModel : public QSortFilterProxyModel,
 
     Q_PROPERTY(int count READ count NOTIFY countChanged)
     Q_PROPERTY(bool delayed READ delayed WRITE setDelayed NOTIFY delayedChanged)
+    Q_PROPERTY(bool cacheRoles READ cacheRoles WRITE setCacheRoles NOTIFY cacheRolesChanged)
+    Q_PROPERTY(bool parallelFiltering READ parallelFiltering WRITE setParallelFiltering NOTIFY parallelFilteringChanged)
 
     Q_PROPERTY(QString filterRoleName READ filterRoleName WRITE setFilterRoleName NOTIFY filterRoleNameChanged)
     Q_PROPERTY(QString filterPattern READ filterPattern WRITE setFilterPattern NOTIFY filterPatternChanged)
@@ -52,6 +58,12 @@ public:
     bool delayed() const;
     void setDelayed(bool delayed);
 
+    bool cacheRoles() const;
+    void setCacheRoles(bool cacheRoles);
+
+    bool parallelFiltering() const;
+    void setParallelFiltering(bool parallelFiltering);
+
     const QString& filterRoleName() const;
     void setFilterRoleName(const QString& filterRoleName);
 
@@ -71,6 +83,8 @@ public:
     void componentComplete() override;
 
     QVariant sourceData(const QModelIndex& sourceIndex) const;
+    // Whether sourceData(sourceIndex) returns what the source model's get() method returns.
+    bool hasSourceGetMethod() const;
     QVariant sourceData(const QModelIndex& sourceIndex, const QString& roleName) const;
     QVariant sourceData(const QModelIndex& sourceIndex, int role) const;
 
@@ -79,6 +93,15 @@ public:
 
     Q_INVOKABLE int roleForName(const QString& roleName) const;
 
+    // Changes whenever roleNames() may have changed, see CachedRole.
+    int rolesRevision() const;
+
+    // Proxy roles are computed by the proxy model, every other role is a source role.
+    bool isProxyRole(int role) const;
+
+    // Cached values of a role used by the filters or sorters, nullptr when not cached (e.g. for columns other than 0).
+    const RoleColumnCache::Column* cachedRoleColumn(const QModelIndex& sourceIndex, int role) const;
+
     Q_INVOKABLE QVariantMap get(int row) const;
     Q_INVOKABLE QVariant get(int row, const QString& roleName) const;
 
@@ -92,6 +115,8 @@ public:
 Q_SIGNALS:
     void countChanged();
     void delayedChanged();
+    void cacheRolesChanged();
+    void parallelFilteringChanged();
 
     void filterRoleNameChanged();
     void filterPatternChanged();
@@ -109,6 +134,7 @@ protected Q_SLOTS:
 
 private Q_SLOTS:
     void queueInvalidateFilter();
+    void queueFilterChange(JApp::Models::Filter::Change change);
     void invalidateFilter();
     void queueInvalidate();
     void invalidate();
@@ -120,9 +146,21 @@ private Q_SLOTS:
     void onDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles);
     void queueInvalidateProxyRoles();
     void invalidateProxyRoles();
+    void updateSortedSorters();
+    void resetRowCaches();
+    void onSourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles);
+    void onSourceRowsInserted(const QModelIndex& parent, int first, int last);
+    void onSourceRowsRemoved(const QModelIndex& parent, int first, int last);
 
 private:
     QVariantMap modelDataMap(const QModelIndex& modelIndex) const;
+    QVector<int> usedRoles() const;
+
+    bool filtersAcceptRow(const QModelIndex& sourceIndex) const;
+    bool isRowUnaffectedByFilterChange(int sourceRow, const QModelIndex& sourceParent) const;
+    bool canFilterInParallel() const;
+    void filterInParallel();
+    void buildRootMapping();
 
     void onFilterAppended(Filter* filter) override;
     void onFilterRemoved(Filter* filter) override;
@@ -147,6 +185,19 @@ private:
     QHash<int, QByteArray> m_roleNames;
     QHash<int, QPair<ProxyRole*, QString>> m_proxyRoleMap;
     QVector<int> m_proxyRoleNumbers;
+    int m_rolesRevision = 0;
+    QList<Sorter*> m_sortedSorters;
+    bool m_cacheRoles = false;
+    mutable RoleColumnCache m_roleCache;
+    bool m_parallelFiltering = false;
+    // Result of the filters for each top level source row, computed in parallel before a filtering pass.
+    // One byte per row rather than bits, so that threads never write to the same byte.
+    std::vector<quint8> m_parallelAcceptedRows;
+
+    // Kind of the pending filter change, and of the one being applied with the rows accepted before it
+    Filter::Change m_filterChange = Filter::Change::Any;
+    Filter::Change m_appliedFilterChange = Filter::Change::Any;
+    QBitArray m_acceptedSourceRows;
 
     bool m_invalidateFilterQueued = false;
     bool m_invalidateQueued = false;
@@ -0,0 +1,232 @@
+#include "rolecolumncache.h"
+#include <QAbstractItemModel>
+#include <cmath>
+
+using namespace JApp::Models;
+
+RoleColumnCache::Column::Column(int role) : m_role(role)
+{
+}
+
+int RoleColumnCache::Column::role() const
+{
+    return m_role;
+}
+
+QVariant RoleColumnCache::Column::value(int row) const
+{
+    switch (m_type) {
+    case Type::Integer:
+        switch (m_metaType.id()) {
+        case QMetaType::Int:
+            return QVariant(static_cast<int>(m_integers[row]));
+        case QMetaType::UInt:
+            return QVariant(static_cast<uint>(m_integers[row]));
+        default:
+            return QVariant(static_cast<qlonglong>(m_integers[row]));
+        }
+    case Type::Double:
+        if (m_metaType.id() == QMetaType::Float)
+            return QVariant(static_cast<float>(m_doubles[row]));
+        return QVariant(m_doubles[row]);
+    case Type::String:
+        return QVariant(m_strings[row]);
+    case Type::Bool:
+        return QVariant(m_booleans[row] != 0);
+    case Type::Variant:
+        return m_variants[row];
+    case Type::Empty:
+        break;
+    }
+    return QVariant();
+}
+
+QPartialOrdering RoleColumnCache::Column::compare(int leftRow, int rightRow) const
+{
+    switch (m_type) {
+    case Type::Integer: {
+        const qint64 left = m_integers[leftRow];
+        const qint64 right = m_integers[rightRow];
+        return left < right ? QPartialOrdering::Less : right < left ? QPartialOrdering::Greater : QPartialOrdering::Equivalent;
+    }
+    case Type::Double: {
+        const double left = m_doubles[leftRow];
+        const double right = m_doubles[rightRow];
+        if (std::isnan(left) || std::isnan(right))
+            return QPartialOrdering::Unordered;
+        return left < right ? QPartialOrdering::Less : right < left ? QPartialOrdering::Greater : QPartialOrdering::Equivalent;
+    }
+    case Type::String: {
+        const int comparison = m_strings[leftRow].compare(m_strings[rightRow]);
+        return comparison < 0 ? QPartialOrdering::Less : comparison > 0 ? QPartialOrdering::Greater : QPartialOrdering::Equivalent;
+    }
+    case Type::Bool: {
+        const int comparison = int(m_booleans[leftRow]) - int(m_booleans[rightRow]);
+        return comparison < 0 ? QPartialOrdering::Less : comparison > 0 ? QPartialOrdering::Greater : QPartialOrdering::Equivalent;
+    }
+    case Type::Variant:
+        return QVariant::compare(m_variants[leftRow], m_variants[rightRow]);
+    case Type::Empty:
+        break;
+    }
+    return QPartialOrdering::Equivalent;
+}
+
+RoleColumnCache::Column::Type RoleColumnCache::Column::typeFor(const QMetaType& metaType)
+{
+    switch (metaType.id()) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+        return Type::Integer;
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return Type::Double;
+    case QMetaType::QString:
+        return Type::String;
+    case QMetaType::Bool:
+        return Type::Bool;
+    default:
+        return Type::Variant;
+    }
+}
+
+void RoleColumnCache::Column::set(int row, const QVariant& value)
+{
+    if (m_type == Type::Empty) {
+        m_type = typeFor(value.metaType());
+        m_metaType = value.metaType();
+        switch (m_type) {
+        case Type::Integer: m_integers.assign(m_size, 0); break;
+        case Type::Double:  m_doubles.assign(m_size, 0.0); break;
+        case Type::String:  m_strings.resize(m_size); break;
+        case Type::Bool:    m_booleans.assign(m_size, 0); break;
+        default:            m_variants.resize(m_size); break;
+        }
+    } else if (m_type != Type::Variant && value.metaType() != m_metaType) {
+        convertToVariant();
+    }
+
+    switch (m_type) {
+    case Type::Integer: m_integers[row] = value.toLongLong(); break;
+    case Type::Double:  m_doubles[row] = value.toDouble(); break;
+    case Type::String:  m_strings[row] = value.toString(); break;
+    case Type::Bool:    m_booleans[row] = value.toBool(); break;
+    default:            m_variants[row] = value; break;
+    }
+}
+
+void RoleColumnCache::Column::insert(int row, int count)
+{
+    m_size += count;
+    switch (m_type) {
+    case Type::Integer: m_integers.insert(m_integers.begin() + row, count, 0); break;
+    case Type::Double:  m_doubles.insert(m_doubles.begin() + row, count, 0.0); break;
+    case Type::String:  m_strings.insert(row, count, QString()); break;
+    case Type::Bool:    m_booleans.insert(m_booleans.begin() + row, count, 0); break;
+    case Type::Variant: m_variants.insert(row, count, QVariant()); break;
+    case Type::Empty:   break;
+    }
+}
+
+void RoleColumnCache::Column::remove(int row, int count)
+{
+    m_size -= count;
+    switch (m_type) {
+    case Type::Integer: m_integers.erase(m_integers.begin() + row, m_integers.begin() + row + count); break;
+    case Type::Double:  m_doubles.erase(m_doubles.begin() + row, m_doubles.begin() + row + count); break;
+    case Type::String:  m_strings.remove(row, count); break;
+    case Type::Bool:    m_booleans.erase(m_booleans.begin() + row, m_booleans.begin() + row + count); break;
+    case Type::Variant: m_variants.remove(row, count); break;
+    case Type::Empty:   break;
+    }
+}
+
+void RoleColumnCache::Column::convertToVariant()
+{
+    QVector<QVariant> variants;
+    variants.reserve(m_size);
+    for (int row = 0; row < m_size; ++row)
+        variants.append(value(row));
+
+    m_variants = std::move(variants);
+    m_integers = {};
+    m_doubles = {};
+    m_strings = {};
+    m_booleans = {};
+    m_type = Type::Variant;
+}
+
+bool RoleColumnCache::isValid() const
+{
+    return m_valid;
+}
+
+void RoleColumnCache::invalidate()
+{
+    m_valid = false;
+    m_columns.clear();
+    m_rowCount = 0;
+}
+
+void RoleColumnCache::build(const QAbstractItemModel& model, const QVector<int>& roles)
+{
+    invalidate();
+    m_rowCount = model.rowCount();
+    m_columns.reserve(roles.size());
+    for (int role : roles) {
+        Column& column = m_columns.emplace_back(role);
+        column.m_size = m_rowCount;
+        for (int row = 0; row < m_rowCount; ++row)
+            column.set(row, model.data(model.index(row, 0), role));
+    }
+    m_valid = true;
+}
+
+void RoleColumnCache::updateRows(const QAbstractItemModel& model, int first, int last, const QVector<int>& roles)
+{
+    if (!m_valid)
+        return;
+
+    for (Column& column : m_columns) {
+        if (!roles.isEmpty() && !roles.contains(column.m_role))
+            continue;
+        for (int row = first; row <= last && row < m_rowCount; ++row)
+            column.set(row, model.data(model.index(row, 0), column.m_role));
+    }
+}
+
+void RoleColumnCache::insertRows(const QAbstractItemModel& model, int first, int last)
+{
+    if (!m_valid)
+        return;
+
+    const int count = last - first + 1;
+    m_rowCount += count;
+    for (Column& column : m_columns) {
+        column.insert(first, count);
+        for (int row = first; row <= last; ++row)
+            column.set(row, model.data(model.index(row, 0), column.m_role));
+    }
+}
+
+void RoleColumnCache::removeRows(int first, int last)
+{
+    if (!m_valid)
+        return;
+
+    const int count = last - first + 1;
+    m_rowCount -= count;
+    for (Column& column : m_columns)
+        column.remove(first, count);
+}
+
+const RoleColumnCache::Column* RoleColumnCache::column(int role) const
+{
+    // A handful of columns at most, a linear scan beats hashing
+    for (const Column& column : m_columns) {
+        if (column.m_role == role)
+            return &column;
+    }
+    return nullptr;
+}
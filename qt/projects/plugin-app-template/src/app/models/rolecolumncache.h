@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QMetaType>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <vector>
+
+class QAbstractItemModel;
+
+namespace JApp::Models {
+
+// Values of a few source roles for every top level source row, kept in typed contiguous
+// arrays so that filters and sorters read them without calling QAbstractItemModel::data().
+// A column whose values don't all share one integer, floating point, string or boolean
+// type falls back to QVariant storage.
+class RoleColumnCache
+{
+public:
+    class Column
+    {
+    public:
+        explicit Column(int role);
+
+        int role() const;
+        QVariant value(int row) const;
+        QPartialOrdering compare(int leftRow, int rightRow) const;
+
+    private:
+        friend class RoleColumnCache;
+
+        enum class Type {
+            Empty,
+            Integer,
+            Double,
+            String,
+            Bool,
+            Variant
+        };
+
+        static Type typeFor(const QMetaType& metaType);
+        void set(int row, const QVariant& value);
+        void insert(int row, int count);
+        void remove(int row, int count);
+        void convertToVariant();
+
+        int m_role;
+        int m_size = 0;
+        Type m_type = Type::Empty;
+        QMetaType m_metaType;
+        std::vector<qint64> m_integers;
+        std::vector<double> m_doubles;
+        QVector<QString> m_strings;
+        std::vector<quint8> m_booleans;
+        QVector<QVariant> m_variants;
+    };
+
+    bool isValid() const;
+    void invalidate();
+
+    // Reads every row of the given roles. The cache stays valid until invalidate().
+    void build(const QAbstractItemModel& model, const QVector<int>& roles);
+
+    // Incremental updates, for top level source rows only.
+    void updateRows(const QAbstractItemModel& model, int first, int last, const QVector<int>& roles);
+    void insertRows(const QAbstractItemModel& model, int first, int last);
+    void removeRows(int first, int last);
+
+    // nullptr if the role isn't cached.
+    const Column* column(int role) const;
+
+private:
+    std::vector<Column> m_columns;
+    int m_rowCount = 0;
+    bool m_valid = false;
+};
+
+}
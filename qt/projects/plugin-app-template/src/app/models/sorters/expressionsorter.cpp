@@ -1,6 +1,7 @@
 #include "expressionsorter.h"
 #include "qqmlsortfilterproxymodel.h"
 #include <QtQml>
+#include <algorithm>
 
 using namespace JApp::Models;
 
@@ -57,6 +58,43 @@ void ExpressionSorter::setExpression(const QQmlScriptString& scriptString)
     invalidate();
 }
 
+/*!
+    \qmlproperty expression ExpressionSorter::keyExpression
+
+    An expression computing the sort key of a row, as an alternative to \l expression.
+    Data for each row is exposed like for a delegate of a QML View, through \c model and \c index.
+    Rows are sorted by comparing their keys natively, so the expression is evaluated once per row instead of twice per comparison:
+    \code
+    sorters: ExpressionSorter {
+        keyExpression: model.lastName.toLowerCase()
+    }
+    \endcode
+    Keys of the same type are compared like for a \l RoleSorter, strings are compared without collation.
+    The keys of top level rows are cached and recomputed for the rows whose data changes.
+    When \c keyExpression is set, \l expression is ignored.
+
+    Like for \l expression, the properties the key depends on are captured by first evaluating it with invalid data.
+*/
+const QQmlScriptString& ExpressionSorter::keyExpression() const
+{
+    return m_keyScriptString;
+}
+
+void ExpressionSorter::setKeyExpression(const QQmlScriptString& scriptString)
+{
+    if (m_keyScriptString == scriptString)
+        return;
+
+    m_keyScriptString = scriptString;
+    delete m_rowKeyExpression;
+    m_rowKeyExpression = nullptr;
+    sourceRowsReset();
+    updateKeyExpression();
+
+    Q_EMIT keyExpressionChanged();
+    invalidate();
+}
+
 void ExpressionSorter::proxyModelCompleted(const QQmlSortFilterProxyModel& proxyModel)
 {
     updateContext(proxyModel);
@@ -80,8 +118,52 @@ bool evaluateBoolExpression(QQmlExpression& expression)
     }
 }
 
+void ExpressionSorter::sourceRowsReset()
+{
+    m_keys.clear();
+    m_keysValid = false;
+}
+
+void ExpressionSorter::sourceRowsInserted(int first, int last, const QQmlSortFilterProxyModel& proxyModel)
+{
+    if (!m_keysValid)
+        return;
+
+    QVector<QVariant> keys;
+    keys.reserve(last - first + 1);
+    for (int row = first; row <= last; ++row)
+        keys.append(evaluateKey(proxyModel.sourceModel()->index(row, 0), proxyModel));
+    m_keys.insert(first, keys.size(), QVariant());
+    std::move(keys.begin(), keys.end(), m_keys.begin() + first);
+}
+
+void ExpressionSorter::sourceRowsRemoved(int first, int last)
+{
+    if (!m_keysValid)
+        return;
+
+    m_keys.remove(first, last - first + 1);
+}
+
+void ExpressionSorter::sourceRowsChanged(int first, int last, const QVector<int>& roles, const QQmlSortFilterProxyModel& proxyModel)
+{
+    // The expression can read any role through model
+    Q_UNUSED(roles)
+    if (!m_keysValid)
+        return;
+
+    for (int row = first; row <= last; ++row)
+        m_keys[row] = evaluateKey(proxyModel.sourceModel()->index(row, 0), proxyModel);
+}
+
 int ExpressionSorter::compare(const QModelIndex& sourceLeft, const QModelIndex& sourceRight, const QQmlSortFilterProxyModel& proxyModel) const
 {
+    if (!m_keyScriptString.isEmpty()) {
+        if (ensureKeys(sourceLeft, proxyModel) && ensureKeys(sourceRight, proxyModel))
+            return toInt(QVariant::compare(m_keys.at(sourceLeft.row()), m_keys.at(sourceRight.row())));
+        return toInt(QVariant::compare(evaluateKey(sourceLeft, proxyModel), evaluateKey(sourceRight, proxyModel)));
+    }
+
     if (!m_scriptString.isEmpty()) {
         QQmlContext context(qmlContext(this));
 
@@ -121,7 +203,12 @@ void ExpressionSorter::updateContext(const QQmlSortFilterProxyModel& proxyModel)
     m_context->setContextProperty("modelLeft", modelLeftMap);
     m_context->setContextProperty("modelRight", modelRightMap);
 
+    // For the key expression
+    m_context->setContextProperty("model", modelLeftMap);
+    m_context->setContextProperty("index", -1);
+
     updateExpression();
+    updateKeyExpression();
 }
 
 void ExpressionSorter::updateExpression()
@@ -135,3 +222,62 @@ void ExpressionSorter::updateExpression()
     m_expression->setNotifyOnValueChanged(true);
     m_expression->evaluate();
 }
+
+void ExpressionSorter::updateKeyExpression()
+{
+    if (!m_context)
+        return;
+
+    delete m_keyExpression;
+    m_keyExpression = nullptr;
+    if (m_keyScriptString.isEmpty())
+        return;
+
+    m_keyExpression = new QQmlExpression(m_keyScriptString, m_context, 0, this);
+    connect(m_keyExpression, &QQmlExpression::valueChanged, this, &ExpressionSorter::invalidateKeys);
+    m_keyExpression->setNotifyOnValueChanged(true);
+    m_keyExpression->evaluate();
+}
+
+void ExpressionSorter::invalidateKeys()
+{
+    sourceRowsReset();
+    invalidate();
+}
+
+bool ExpressionSorter::ensureKeys(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const
+{
+    // Keys are evaluated for column 0 of top level rows
+    if (sourceIndex.column() != 0 || sourceIndex.parent().isValid())
+        return false;
+
+    if (!m_keysValid) {
+        const int rowCount = proxyModel.sourceModel()->rowCount();
+        m_keys.clear();
+        m_keys.reserve(rowCount);
+        for (int row = 0; row < rowCount; ++row)
+            m_keys.append(evaluateKey(proxyModel.sourceModel()->index(row, 0), proxyModel));
+        m_keysValid = true;
+    }
+    return sourceIndex.row() < m_keys.size();
+}
+
+QVariant ExpressionSorter::evaluateKey(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const
+{
+    if (!m_rowKeyExpression) {
+        auto self = const_cast<ExpressionSorter*>(this);
+        if (!m_rowContext)
+            m_rowContext = new QQmlContext(qmlContext(this), self);
+        m_rowKeyExpression = new QQmlExpression(m_keyScriptString, m_rowContext, nullptr, self);
+    }
+
+    m_rowContext->setContextProperty("index", sourceIndex.row());
+    m_rowContext->setContextProperty("model", proxyModel.sourceData(sourceIndex));
+    m_rowKeyExpression->clearError();
+    const QVariant key = m_rowKeyExpression->evaluate();
+    if (m_rowKeyExpression->hasError()) {
+        qWarning() << m_rowKeyExpression->error();
+        return QVariant();
+    }
+    return key;
+}
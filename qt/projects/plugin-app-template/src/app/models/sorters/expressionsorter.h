@@ -2,6 +2,8 @@
 
 #include "sorter.h"
 #include <QQmlScriptString>
+#include <QVariant>
+#include <QVector>
 
 class QQmlExpression;
 
@@ -13,6 +15,7 @@ class ExpressionSorter : public Sorter
 {
     Q_OBJECT
     Q_PROPERTY(QQmlScriptString expression READ expression WRITE setExpression NOTIFY expressionChanged)
+    Q_PROPERTY(QQmlScriptString keyExpression READ keyExpression WRITE setKeyExpression NOTIFY keyExpressionChanged)
 
 public:
     using Sorter::Sorter;
@@ -20,10 +23,19 @@ public:
     const QQmlScriptString& expression() const;
     void setExpression(const QQmlScriptString& scriptString);
 
+    const QQmlScriptString& keyExpression() const;
+    void setKeyExpression(const QQmlScriptString& scriptString);
+
     void proxyModelCompleted(const QQmlSortFilterProxyModel& proxyModel) override;
 
+    void sourceRowsReset() override;
+    void sourceRowsInserted(int first, int last, const QQmlSortFilterProxyModel& proxyModel) override;
+    void sourceRowsRemoved(int first, int last) override;
+    void sourceRowsChanged(int first, int last, const QVector<int>& roles, const QQmlSortFilterProxyModel& proxyModel) override;
+
 Q_SIGNALS:
     void expressionChanged();
+    void keyExpressionChanged();
 
 protected:
     int compare(const QModelIndex& sourceLeft, const QModelIndex& sourceRight, const QQmlSortFilterProxyModel& proxyModel) const override;
@@ -31,10 +43,25 @@ protected:
 private:
     void updateContext(const QQmlSortFilterProxyModel& proxyModel);
     void updateExpression();
+    void updateKeyExpression();
+    void invalidateKeys();
+    bool ensureKeys(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const;
+    QVariant evaluateKey(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const;
 
     QQmlScriptString m_scriptString;
     QQmlExpression* m_expression = nullptr;
     QQmlContext* m_context = nullptr;
+
+    QQmlScriptString m_keyScriptString;
+    QQmlExpression* m_keyExpression = nullptr; // Only tracks the properties the key depends on
+
+    // Evaluates the key expression for each row, created once and rebound to every row
+    mutable QQmlContext* m_rowContext = nullptr;
+    mutable QQmlExpression* m_rowKeyExpression = nullptr;
+
+    // Keys of the top level source rows, built on the first comparison
+    mutable QVector<QVariant> m_keys;
+    mutable bool m_keysValid = false;
 };
 
 }
@@ -52,6 +52,14 @@ void FilterSorter::proxyModelCompleted(const QQmlSortFilterProxyModel& proxyMode
         filter->proxyModelCompleted(proxyModel);
 }
 
+void FilterSorter::appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const
+{
+    for (Filter* filter : m_filters) {
+        if (filter->enabled())
+            filter->appendUsedRoles(proxyModel, roles);
+    }
+}
+
 void FilterSorter::onFilterAppended(Filter* filter)
 {
     connect(filter, &Filter::invalidated, this, &FilterSorter::invalidate);
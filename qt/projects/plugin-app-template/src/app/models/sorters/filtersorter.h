@@ -20,6 +20,7 @@ protected:
 
 private:
     void proxyModelCompleted(const QQmlSortFilterProxyModel& proxyModel) override;
+    void appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const override;
     void onFilterAppended(Filter *filter) override;
     void onFilterRemoved(Filter *filter) override;
     void onFiltersCleared() override;
@@ -0,0 +1,67 @@
+#include "predicatesorter.h"
+#include "qqmlsortfilterproxymodel.h"
+#include <JApp/Log.h>
+
+using namespace JApp::Models;
+
+/*!
+    \qmltype PredicateSorter
+    \inherits Sorter
+    \inqmlmodule SortFilterProxyModel
+    \ingroup Sorters
+    \brief Sorts rows with a native predicate expression.
+
+    A PredicateSorter is a \l Sorter comparing rows with a predicate expression, like \l ExpressionSorter,
+    but compiled once by the model and evaluated without the javascript engine.
+
+    \code
+    SortFilterProxyModel {
+       sourceModel: contactModel
+       sorters: PredicateSorter {
+           expression: "modelLeft.age < modelRight.age"
+       }
+    }
+    \endcode
+*/
+
+/*!
+    \qmlproperty string PredicateSorter::expression
+
+    The predicate returning \c true if the left row is less than the right row, \c false otherwise.
+    Roles of the rows are read with \c modelLeft.role and \c modelRight.role, and their indexes with \c modelLeft.index and \c modelRight.index.
+    The syntax is the one of \l {PredicateFilter::expression} {PredicateFilter}.
+
+    Rows are left in the source model order when the expression is empty or doesn't parse, in which case a warning is logged.
+*/
+const QString& PredicateSorter::expression() const
+{
+    return m_predicate.source();
+}
+
+void PredicateSorter::setExpression(const QString& expression)
+{
+    if (m_predicate.source() == expression)
+        return;
+
+    if (!m_predicate.compile(expression))
+        LOG_WARN() << "Failed to parse predicate" << expression << ":" << m_predicate.errorString();
+
+    Q_EMIT expressionChanged();
+    invalidate();
+}
+
+void PredicateSorter::appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const
+{
+    m_predicate.appendUsedRoles(proxyModel, roles);
+}
+
+int PredicateSorter::compare(const QModelIndex& sourceLeft, const QModelIndex& sourceRight, const QQmlSortFilterProxyModel& proxyModel) const
+{
+    if (m_predicate.isEmpty())
+        return 0;
+    if (m_predicate.evaluate(sourceLeft, sourceRight, proxyModel).isTruthy())
+        return -1;
+    if (m_predicate.evaluate(sourceRight, sourceLeft, proxyModel).isTruthy())
+        return 1;
+    return 0;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "sorter.h"
+#include "predicate.h"
+
+namespace JApp::Models {
+
+class PredicateSorter : public Sorter
+{
+    Q_OBJECT
+    Q_PROPERTY(QString expression READ expression WRITE setExpression NOTIFY expressionChanged)
+
+public:
+    using Sorter::Sorter;
+
+    const QString& expression() const;
+    void setExpression(const QString& expression);
+
+    void appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const override;
+
+Q_SIGNALS:
+    void expressionChanged();
+
+protected:
+    int compare(const QModelIndex& sourceLeft, const QModelIndex& sourceRight, const QQmlSortFilterProxyModel& proxyModel) const override;
+
+private:
+    Predicate m_predicate;
+};
+
+}
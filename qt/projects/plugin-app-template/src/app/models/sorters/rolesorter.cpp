@@ -29,23 +29,33 @@ using namespace JApp::Models;
 */
 const QString& RoleSorter::roleName() const
 {
-    return m_roleName;
+    return m_role.name();
 }
 
 void RoleSorter::setRoleName(const QString& roleName)
 {
-    if (m_roleName == roleName)
+    if (m_role.name() == roleName)
         return;
 
-    m_roleName = roleName;
+    m_role.setName(roleName);
     Q_EMIT roleNameChanged();
     invalidate();
 }
 
+void RoleSorter::appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const
+{
+    roles.append(m_role.role(proxyModel));
+}
+
+int RoleSorter::role(const QQmlSortFilterProxyModel& proxyModel) const
+{
+    return m_role.role(proxyModel);
+}
+
 QPair<QVariant, QVariant> RoleSorter::sourceData(const QModelIndex &sourceLeft, const QModelIndex& sourceRight, const QQmlSortFilterProxyModel& proxyModel) const
 {
     QPair<QVariant, QVariant> pair;
-    int role = proxyModel.roleForName(m_roleName);
+    const int role = m_role.role(proxyModel);
 
     if (role == -1)
         return pair;
@@ -57,6 +67,16 @@ QPair<QVariant, QVariant> RoleSorter::sourceData(const QModelIndex &sourceLeft,
 
 int RoleSorter::compare(const QModelIndex &sourceLeft, const QModelIndex& sourceRight, const QQmlSortFilterProxyModel& proxyModel) const
 {
+    // Typed comparison straight from the role cache, without building QVariants
+    if (const RoleColumnCache::Column* column = proxyModel.cachedRoleColumn(sourceLeft, m_role.role(proxyModel))) {
+        QPartialOrdering comparisonResult = column->compare(sourceLeft.row(), sourceRight.row());
+        if (comparisonResult == QPartialOrdering::Unordered)
+        {
+            LOG_WARN() << "Failed to sort roles, comparison failed: " << column->value(sourceLeft.row()) << column->value(sourceRight.row());
+        }
+        return toInt(comparisonResult);
+    }
+
     const QPair<QVariant, QVariant> pair = sourceData(sourceLeft, sourceRight, proxyModel);
     QPartialOrdering comparisonResult = QVariant::compare(pair.first, pair.second);
     if (comparisonResult == QPartialOrdering::Unordered)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "sorter.h"
+#include "cachedrole.h"
 
 namespace JApp::Models {
 
@@ -15,15 +16,18 @@ public:
     const QString& roleName() const;
     void setRoleName(const QString& roleName);
 
+    void appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const override;
+
 Q_SIGNALS:
     void roleNameChanged();
 
 protected:
+    int role(const QQmlSortFilterProxyModel& proxyModel) const;
     QPair<QVariant, QVariant> sourceData(const QModelIndex &sourceLeft, const QModelIndex& sourceRight, const QQmlSortFilterProxyModel& proxyModel) const;
     int compare(const QModelIndex& sourceLeft, const QModelIndex& sourceRight, const QQmlSortFilterProxyModel& proxyModel) const override;
 
 private:
-    QString m_roleName;
+    CachedRole m_role;
 };
 
 }
@@ -125,6 +125,37 @@ void Sorter::proxyModelCompleted(const QQmlSortFilterProxyModel& proxyModel)
     Q_UNUSED(proxyModel)
 }
 
+void Sorter::appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const
+{
+    Q_UNUSED(proxyModel)
+    Q_UNUSED(roles)
+}
+
+void Sorter::sourceRowsReset()
+{
+}
+
+void Sorter::sourceRowsInserted(int first, int last, const QQmlSortFilterProxyModel& proxyModel)
+{
+    Q_UNUSED(first)
+    Q_UNUSED(last)
+    Q_UNUSED(proxyModel)
+}
+
+void Sorter::sourceRowsRemoved(int first, int last)
+{
+    Q_UNUSED(first)
+    Q_UNUSED(last)
+}
+
+void Sorter::sourceRowsChanged(int first, int last, const QVector<int>& roles, const QQmlSortFilterProxyModel& proxyModel)
+{
+    Q_UNUSED(first)
+    Q_UNUSED(last)
+    Q_UNUSED(roles)
+    Q_UNUSED(proxyModel)
+}
+
 int Sorter::toInt(QPartialOrdering o)
 {
     if (o == QPartialOrdering::Greater) return 1;
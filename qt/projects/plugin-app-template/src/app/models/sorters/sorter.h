@@ -1,6 +1,7 @@
 #pragma once
 
 #include <QObject>
+#include <QVector>
 
 namespace JApp::Models {
 
@@ -34,6 +35,16 @@ public:
 
     virtual void proxyModelCompleted(const QQmlSortFilterProxyModel& proxyModel);
 
+    // Source roles read by compare(), cached by the proxy model when cacheRoles is set.
+    virtual void appendUsedRoles(const QQmlSortFilterProxyModel& proxyModel, QVector<int>& roles) const;
+
+    // Top level source row notifications, for sorters keeping data per source row.
+    // sourceRowsReset() is also called when proxy roles are invalidated.
+    virtual void sourceRowsReset();
+    virtual void sourceRowsInserted(int first, int last, const QQmlSortFilterProxyModel& proxyModel);
+    virtual void sourceRowsRemoved(int first, int last);
+    virtual void sourceRowsChanged(int first, int last, const QVector<int>& roles, const QQmlSortFilterProxyModel& proxyModel);
+
     static int toInt(QPartialOrdering o);
 
 Q_SIGNALS:
@@ -3,6 +3,7 @@
 #include "stringsorter.h"
 #include "filtersorter.h"
 #include "expressionsorter.h"
+#include "predicatesorter.h"
 #include "sortercontainer.h"
 #include <QQmlEngine>
 #include <QCoreApplication>
@@ -15,6 +16,7 @@ void registerSorterTypes() {
     qmlRegisterType<StringSorter>("SortFilterProxyModel", 0, 2, "StringSorter");
     qmlRegisterType<FilterSorter>("SortFilterProxyModel", 0, 2, "FilterSorter");
     qmlRegisterType<ExpressionSorter>("SortFilterProxyModel", 0, 2, "ExpressionSorter");
+    qmlRegisterType<PredicateSorter>("SortFilterProxyModel", 0, 2, "PredicateSorter");
     qmlRegisterUncreatableType<SorterContainerAttached>("SortFilterProxyModel", 0, 2, "SorterContainer", "SorterContainer can only be used as an attaching type");
 }
 
@@ -1,4 +1,5 @@
 #include "stringsorter.h"
+#include "qqmlsortfilterproxymodel.h"
 
 using namespace JApp::Models;
 
@@ -11,6 +12,8 @@ using namespace JApp::Models;
 
     \l StringSorter is a specialized \l RoleSorter that sorts rows based on a source model string role.
     \l StringSorter compares strings according to a localized collation algorithm.
+    The collation key of each top level row is computed once and kept up to date as the source model changes,
+    so sorting compares precomputed keys.
 
     In the following example, rows with be sorted by their \c lastName role :
     \code
@@ -37,6 +40,7 @@ void StringSorter::setCaseSensitivity(Qt::CaseSensitivity caseSensitivity)
         return;
 
     m_collator.setCaseSensitivity(caseSensitivity);
+    sourceRowsReset();
     Q_EMIT caseSensitivityChanged();
     invalidate();
 }
@@ -60,6 +64,7 @@ void StringSorter::setIgnorePunctation(bool ignorePunctation)
         return;
 
     m_collator.setIgnorePunctuation(ignorePunctation);
+    sourceRowsReset();
     Q_EMIT ignorePunctationChanged();
     invalidate();
 }
@@ -80,6 +85,7 @@ void StringSorter::setLocale(const QLocale &locale)
         return;
 
     m_collator.setLocale(locale);
+    sourceRowsReset();
     Q_EMIT localeChanged();
     invalidate();
 }
@@ -102,12 +108,76 @@ void StringSorter::setNumericMode(bool numericMode)
         return;
 
     m_collator.setNumericMode(numericMode);
+    sourceRowsReset();
     Q_EMIT numericModeChanged();
     invalidate();
 }
 
+void StringSorter::sourceRowsReset()
+{
+    m_sortKeys.clear();
+    m_sortKeysValid = false;
+}
+
+void StringSorter::sourceRowsInserted(int first, int last, const QQmlSortFilterProxyModel& proxyModel)
+{
+    if (!m_sortKeysValid)
+        return;
+
+    std::vector<QCollatorSortKey> keys;
+    keys.reserve(last - first + 1);
+    for (int row = first; row <= last; ++row)
+        keys.push_back(sortKey(row, m_sortKeysRole, proxyModel));
+    m_sortKeys.insert(m_sortKeys.begin() + first, keys.begin(), keys.end());
+}
+
+void StringSorter::sourceRowsRemoved(int first, int last)
+{
+    if (!m_sortKeysValid)
+        return;
+
+    m_sortKeys.erase(m_sortKeys.begin() + first, m_sortKeys.begin() + last + 1);
+}
+
+void StringSorter::sourceRowsChanged(int first, int last, const QVector<int>& roles, const QQmlSortFilterProxyModel& proxyModel)
+{
+    if (!m_sortKeysValid || (!roles.isEmpty() && !roles.contains(m_sortKeysRole)))
+        return;
+
+    for (int row = first; row <= last; ++row)
+        m_sortKeys[row] = sortKey(row, m_sortKeysRole, proxyModel);
+}
+
+bool StringSorter::ensureSortKeys(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const
+{
+    // Only column 0 of top level rows of source roles is kept, proxy roles can change without the source model notifying
+    const int role = this->role(proxyModel);
+    if (role < 0 || proxyModel.isProxyRole(role) || sourceIndex.column() != 0 || sourceIndex.parent().isValid())
+        return false;
+
+    if (!m_sortKeysValid || m_sortKeysRole != role) {
+        const int rowCount = proxyModel.sourceModel()->rowCount();
+        m_sortKeys.clear();
+        m_sortKeys.reserve(rowCount);
+        for (int row = 0; row < rowCount; ++row)
+            m_sortKeys.push_back(sortKey(row, role, proxyModel));
+        m_sortKeysRole = role;
+        m_sortKeysValid = true;
+    }
+    return sourceIndex.row() < static_cast<int>(m_sortKeys.size());
+}
+
+QCollatorSortKey StringSorter::sortKey(int row, int role, const QQmlSortFilterProxyModel& proxyModel) const
+{
+    const QModelIndex sourceIndex = proxyModel.sourceModel()->index(row, 0);
+    return m_collator.sortKey(proxyModel.sourceData(sourceIndex, role).toString());
+}
+
 int StringSorter::compare(const QModelIndex &sourceLeft, const QModelIndex &sourceRight, const QQmlSortFilterProxyModel& proxyModel) const
 {
+    if (ensureSortKeys(sourceLeft, proxyModel) && ensureSortKeys(sourceRight, proxyModel))
+        return m_sortKeys[sourceLeft.row()].compare(m_sortKeys[sourceRight.row()]);
+
     QPair<QVariant, QVariant> pair = sourceData(sourceLeft, sourceRight, proxyModel);
     QString leftValue = pair.first.toString();
     QString rightValue = pair.second.toString();
@@ -2,6 +2,7 @@
 
 #include "rolesorter.h"
 #include <QCollator>
+#include <vector>
 
 namespace JApp::Models {
 
@@ -28,6 +29,11 @@ public:
     bool numericMode() const;
     void setNumericMode(bool numericMode);
 
+    void sourceRowsReset() override;
+    void sourceRowsInserted(int first, int last, const QQmlSortFilterProxyModel& proxyModel) override;
+    void sourceRowsRemoved(int first, int last) override;
+    void sourceRowsChanged(int first, int last, const QVector<int>& roles, const QQmlSortFilterProxyModel& proxyModel) override;
+
 Q_SIGNALS:
     void caseSensitivityChanged();
     void ignorePunctationChanged();
@@ -38,7 +44,15 @@ protected:
     int compare(const QModelIndex& sourceLeft, const QModelIndex& sourceRight, const QQmlSortFilterProxyModel& proxyModel) const override;
 
 private:
+    bool ensureSortKeys(const QModelIndex& sourceIndex, const QQmlSortFilterProxyModel& proxyModel) const;
+    QCollatorSortKey sortKey(int row, int role, const QQmlSortFilterProxyModel& proxyModel) const;
+
     QCollator m_collator;
+
+    // Collation keys of the top level source rows, built on the first comparison
+    mutable std::vector<QCollatorSortKey> m_sortKeys;
+    mutable int m_sortKeysRole = -1;
+    mutable bool m_sortKeysValid = false;
 };
 
 }